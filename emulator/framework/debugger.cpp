@@ -21,8 +21,19 @@ static int keyMapping[16];															// Mapping for control keys to key valu
 static int inRunMode = 0;															// Non zero when free Running
 static int lastKey,currentKey;														// Last and Current key state
 static int stepBreakPoint;															// Extra breakpoint used for step over.
-static Uint32 nextFrame = 0;														// Time of next frame.
+static LONG64 pacingBase = 0; 														// Performance counter at frame 0
+static LONG64 pacingFrames = 0; 													// Frames since then.
+static int pacingRate = 0; 															// Frame rate being paced.
+static int warpMode = 0; 															// Non zero when running unthrottled
+static int warpSkip = 1,warpCount = 0; 												// Render one frame in warpSkip
+static LONG64 warpLastEntry = 0; 													// When GFXXRender last called
+static int warpLastRendered = 0; 													// Did that call render ?
+static double warpRenderedTime,warpSkippedTime; 									// Average loop time each way.
+static int isHeadless = 0; 															// Never draw when running
+
+static int DBGWarpRepaint(void);
 static int frameCount = 0;
+static int needClear = -1; 															// Clear before the next debugger draw
 
 #ifdef EMSCRIPTEN
 #define FRAMESKIP 	(1)
@@ -38,6 +49,8 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 
 	frameCount++;
 	int repaint = (frameCount & FRAMESKIP) == 0;
+	if (warpMode != 0 && inRunMode != 0) repaint = DBGWarpRepaint(); 				// Warp decides for itself
+	if (isHeadless != 0 && inRunMode != 0) repaint = 0;
 
 	if (isInitialised == 0) {														// Check if first time
 		isInitialised = 1;															// Now initialised
@@ -53,14 +66,28 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 		DBGDefineKey(DBGKEY_BREAK,GFXKEY_F6);	
 		DBGDefineKey(DBGKEY_HOME,GFXKEY_F2);		
 		DBGDefineKey(DBGKEY_SETBREAK,GFXKEY_F9);		
+		DBGDefineKey(DBGKEY_STATS,GFXKEY_F10);		
+		DBGDefineKey(DBGKEY_WARP,GFXKEY_F11);		
+		DBGDefineKey(DBGKEY_HEATRESET,GFXKEY_F3);		
+		DBGDefineKey(DBGKEY_HEATEXPORT,GFXKEY_F4);		
+		DBGDefineKey(DBGKEY_SCROLLUP,GFXKEY_UP);		
+		DBGDefineKey(DBGKEY_SCROLLDOWN,GFXKEY_DOWN);		
 		lastKey = currentKey = -1;
 	}
 
 	if (repaint) {
-		if (inRunMode != 0 || GFXIsKeyPressed(keyMapping[DBGKEY_SHOW]))				// Display system screen if Run or Sjhow
-			DEBUG_VDURENDER(addressSettings);
-		else 																		// Otherwise show Debugger screen
+		if (inRunMode != 0 || GFXIsKeyPressed(keyMapping[DBGKEY_SHOW])) {			// Display system screen if Run or Sjhow
+			GFXClear();
+			if (inRunMode == 0 || DEBUG_RUNAHEAD(addressSettings) == 0) { 			// Run-ahead may draw it for us.
+				DEBUG_VDURENDER(addressSettings);
+			}
+			needClear = -1; 														// Debugger must start again
+		} else {  																	// Otherwise show Debugger screen
+			if (needClear || DEBUG_OVERLAYSHOWN()) GFXClear(); 						// Only fields that change are redrawn,
+			needClear = 0; 															// unless the overlay is on top of them.
 			DEBUG_CPURENDER(addressSettings);
+		}
+		DEBUG_OVERLAY(); 															// Statistics on top, if on.
 	}
 
 	#ifdef INCLUDE_DEBUGGING_SUPPORT
@@ -74,6 +101,7 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 	}
 	if (currentKey != lastKey) {													// Key changed
 		lastKey = currentKey;														// Update current key.
+		needClear = -1; 															// Redraw the whole debugger.
 		currentKey = DEBUG_KEYMAP(currentKey,inRunMode != 0);						// Pass keypress to called.
 		if (currentKey >= 0) {														// Key depressed ?
 			currentKey = toupper(currentKey);										// Make it capital.
@@ -86,6 +114,19 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 				GFXSilence();
 			}
 
+			if (CMDKEY(DBGKEY_STATS)) { 											// Statistics overlay (F10)
+				DEBUG_TOGGLEOVERLAY();
+			}
+			if (CMDKEY(DBGKEY_WARP)) { 												// Warp on/off (F11)
+				DBGSetWarp(!warpMode);
+			}
+			if (CMDKEY(DBGKEY_HEATRESET)) { 										// Clear memory heatmap (F3)
+				DEBUG_HEATRESET();
+			}
+			if (CMDKEY(DBGKEY_HEATEXPORT)) { 										// Export memory heatmap (F4)
+				DEBUG_HEATEXPORT();
+			}
+
 			if (inRunMode == 0) {
 				GFXSilence();														// Will drive us mental otherwise.
 				if (isxdigit(currentKey)) {											// Is it a hex digit 0-9 A-F.
@@ -120,6 +161,12 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 				if (CMDKEY(DBGKEY_SETBREAK)) {										// Set Breakpoint (F9)
 						addressSettings[3] = addressSettings[0];
 				}
+				if (CMDKEY(DBGKEY_SCROLLUP)) { 										// Scroll code back (Up)
+					addressSettings[0] = DEBUG_PREVIOUS(addressSettings[0]);
+				}
+				if (CMDKEY(DBGKEY_SCROLLDOWN)) { 									// Scroll code forward (Down)
+					addressSettings[0] = DEBUG_NEXT(addressSettings[0]);
+				}
 			} else {																// In Run mode.
 				if (CMDKEY(DBGKEY_BREAK)) {
 					inRunMode = 0;
@@ -130,18 +177,98 @@ int GFXXRender(SDL_Surface *surface,int autoStart) {
 	}
 	#endif
 	if (inRunMode != 0) {															// Running a program.
+		LONG64 startTime = DEBUG_TIMER();
 		int frameRate = DEBUG_RUN(addressSettings[3],stepBreakPoint);				// Run a frame, or try to.
+		DEBUG_TIMECPU(startTime);
 		if (frameRate == 0) {														// Run code with step breakpoint, maybe.
 			inRunMode = 0;															// Break has occurred.
 		} else {
-			while (SDL_GetTicks() < nextFrame) {};									// Wait for frame timer to elapse.
-			nextFrame = SDL_GetTicks() + 1000 / frameRate;							// And calculate the next sync time.
+			if (warpMode == 0) { 													// Unless in warp
+				startTime = DEBUG_TIMER();
+				DBGPaceFrame(frameRate); 											// Wait for frame timer to elapse.
+				DEBUG_TIMEWAIT(startTime);
+			}
 		}
 		addressSettings[0] = DEBUG_HOMEPC();
 	}	
 	return repaint;
 }
 
+// *******************************************************************************************************************************
+//
+//		Wait for the next frame. Deadlines are counted from a base, so rounding and oversleeping don't accumulate and
+//		emulated time tracks wall time. If well behind (after a break, or a slow host) start counting again from now.
+//		With audiosync the sound card's buffer does the pacing instead, and the timer starts again if it is used.
+//
+// *******************************************************************************************************************************
+
+void DBGPaceFrame(int frameRate) {
+	if (DEBUG_PACEAUDIO()) {
+		pacingRate = 0;
+		return;
+	}
+	LONG64 frequency = SDL_GetPerformanceFrequency();
+	LONG64 now = SDL_GetPerformanceCounter();
+	pacingFrames++;
+	LONG64 deadline = pacingBase + pacingFrames * frequency / frameRate;
+	if (frameRate != pacingRate || now > deadline + frequency * DBG_MAX_LAG / 1000) {
+		pacingRate = frameRate;
+		pacingBase = now;pacingFrames = 0; 											// Resynchronise.
+		return;
+	}
+	GFXSleepUntil(deadline);
+}
+
+// *******************************************************************************************************************************
+//
+//		Warp mode. No pacing, and only one frame in N is drawn. The loop time of drawn and skipped frames is averaged, the
+//		difference is the cost of drawing, and N is chosen so that is no more than DBG_WARP_SHARE percent of the time.
+//
+// *******************************************************************************************************************************
+
+void DBGSetWarp(int isOn) {
+	warpMode = (isOn != 0);
+	warpSkip = 1;warpCount = 0;warpLastEntry = 0;
+	warpRenderedTime = warpSkippedTime = 0.0;
+	GFXSetMute(warpMode); 															// Audio would be nonsense.
+	printf("Warp mode %s\n",warpMode ? "on":"off");
+}
+
+static int DBGWarpRepaint(void) {
+	LONG64 now = SDL_GetPerformanceCounter();
+	if (warpLastEntry != 0) { 														// Average the last loop
+		double elapsed = (double)(now - warpLastEntry);
+		if (warpLastRendered) {
+			warpRenderedTime = (warpRenderedTime == 0.0) ? elapsed : warpRenderedTime * 0.9 + elapsed * 0.1;
+		} else {
+			warpSkippedTime = (warpSkippedTime == 0.0) ? elapsed : warpSkippedTime * 0.9 + elapsed * 0.1;
+		}
+	}
+	warpLastEntry = now;
+	warpLastRendered = 0;
+	if (++warpCount < warpSkip) return 0; 											// Skip this one.
+	warpCount = 0;warpLastRendered = -1;
+	if (warpSkippedTime == 0.0) { 													// Need a skipped frame to measure.
+		warpSkip = 2;
+	} else {
+		double drawTime = warpRenderedTime - warpSkippedTime;
+		int n = (drawTime <= 0.0) ? 1 : 1 + (int)(drawTime * (100 - DBG_WARP_SHARE) / (DBG_WARP_SHARE * warpSkippedTime));
+		warpSkip = (n < 2) ? 2 : (n > DBG_WARP_MAX_SKIP ? DBG_WARP_MAX_SKIP : n); 	// Always skip some, to keep measuring
+	}
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//							Headless. No window is shown and nothing drawn, running in warp mode.
+// *******************************************************************************************************************************
+
+void DBGSetHeadless(int isOn) {
+	if (isHeadless == (isOn != 0)) return; 											// Reset parses the options again
+	isHeadless = (isOn != 0);
+	GFXSetHeadless(isHeadless);
+	DBGSetWarp(isHeadless);
+}
+
 // *******************************************************************************************************************************
 //													Redefine a key
 // *******************************************************************************************************************************
@@ -14,6 +14,13 @@
 
 void DBGVerticalLabel(int x,int y,const char *labels[],int fgr,int bgr);
 void DBGDefineKey(int keyID,int gfxKey);
+void DBGPaceFrame(int frameRate);
+void DBGSetWarp(int isOn);
+void DBGSetHeadless(int isOn);
+
+#define DBG_MAX_LAG 	(100) 														// ms behind before pacing resynchronises
+#define DBG_WARP_SHARE 	(10) 														// Most % of time warp spends drawing
+#define DBG_WARP_MAX_SKIP (50) 														// Draw at least one frame in this many
 
 #include "sys_debug_system.h"
 
@@ -25,6 +32,12 @@ void DBGDefineKey(int keyID,int gfxKey);
 #define DBGKEY_BREAK	(5)
 #define DBGKEY_HOME		(6)
 #define DBGKEY_SETBREAK	(7)
+#define DBGKEY_STATS	(8)
+#define DBGKEY_HEATRESET (9)
+#define DBGKEY_HEATEXPORT (10)
+#define DBGKEY_SCROLLUP	(11)
+#define DBGKEY_SCROLLDOWN (12)
+#define DBGKEY_WARP		(13)
 
 #endif
 
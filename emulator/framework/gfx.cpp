@@ -12,20 +12,32 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#include <string.h>
 #include <ctype.h>
 #include "gfx.h"
 #include <queue>
 #include <cmath>
 #include "sys_processor.h"
 #include <hardware.h>
+#include "sys_stats.h"
+#include "sys_latency.h"
+#include "hw_sn76489.h"
 
 #ifdef EMSCRIPTEN
 #include "emscripten.h"
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
 static SDL_Window *mainWindow = NULL;
 static SDL_Surface *mainSurface = NULL;
 static int background;
+static int surfaceChanged = -1; 													// Drawn on since last update ?
+static int isIdle = 0; 																// Last frame drew nothing ?
+static int generation = 0; 															// Bumped every time the screen is cleared.
+static int isHeadless = 0; 															// No real window or audio device
 
 #define RED(x) ((((x) >> 8) & 0xF) * 17)
 #define GREEN(x) ((((x) >> 4) & 0xF) * 17)
@@ -34,7 +46,9 @@ static int background;
 static void _GFXInitialiseKeyRecord(void);
 static void _GFXUpdateKeyRecord(int scancode,int isDown);
 
-static Beeper beeper;
+static SDL_AudioDeviceID audioDevice = 0;
+
+static void _GFXOpenAudio(void);
 
 #include "sdltops2.h"														
 
@@ -50,9 +64,9 @@ void GFXOpenWindow(const char *title,int width,int height,int colour) {
 		exit(printf( "SDL could not initialize! SDL_Error: %s\n", SDL_GetError()));
 	}
 
-	beeper.setup();
+	_GFXOpenAudio();
 	mainWindow = SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, 					// Try to create a window
-							SDL_WINDOWPOS_UNDEFINED, width,height, SDL_WINDOW_SHOWN );
+							SDL_WINDOWPOS_UNDEFINED, width,height, isHeadless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
 	if (mainWindow == NULL) {
 		exit(printf( "Window could not be created! SDL_Error: %s\n", SDL_GetError() ));
 	}
@@ -63,6 +77,26 @@ void GFXOpenWindow(const char *title,int width,int height,int colour) {
 	_GFXInitialiseKeyRecord();														// Set up key system.
 }
 
+// *******************************************************************************************************************************
+//											The window's surface, for capturing it
+// *******************************************************************************************************************************
+
+SDL_Surface *GFXGetSurface(void) {
+	return mainSurface;
+}
+
+// *******************************************************************************************************************************
+//				Run without a display or sound card, using SDL's dummy drivers. Must be set before the window is opened.
+// *******************************************************************************************************************************
+
+void GFXSetHeadless(int isOn) {
+	isHeadless = isOn;
+	if (isOn && mainWindow == NULL) {
+		SDL_setenv("SDL_VIDEODRIVER","dummy",1);
+		SDL_setenv("SDL_AUDIODRIVER","dummy",1);
+	}
+}
+
 // *******************************************************************************************************************************
 //
 //												Start the main rendering loop
@@ -82,33 +116,103 @@ void GFXStart(int autoStart) {
 			_GFXMainLoop(NULL);
 	}
 	#endif
-	SDL_CloseAudio();
+	if (audioDevice != 0) SDL_CloseAudioDevice(audioDevice);
 }
 
 
-static void _GFXMainLoop(void *arg) {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {													// While events in event queue.
-		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {		// Exit if ESC pressed.
-			if ((SDL_GetModState() & KMOD_LCTRL) == 0) isRunning = 0;				// Not Ctrl+ESC
+static void _GFXHandleEvent(SDL_Event *event) {
+	if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_ESCAPE) {		// Exit if ESC pressed.
+		if ((SDL_GetModState() & KMOD_LCTRL) == 0) isRunning = 0;					// Not Ctrl+ESC
+	}
+	if ((event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) && 				// Shift+Insert pastes
+			event->key.keysym.sym == SDLK_INSERT && (SDL_GetModState() & KMOD_SHIFT) != 0) {
+		if (event->type == SDL_KEYDOWN) {
+			char *text = SDL_GetClipboardText();
+			HWTypeText(text,strlen(text),0);
+			SDL_free(text);
 		}
-		if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {					// Handle other keys.
-			_GFXUpdateKeyRecord(event.key.keysym.sym,event.type == SDL_KEYDOWN);
-			for (int kc = 0;kc < 256;kc++) {
-				if (sdlKeySymbolList[kc] == event.key.keysym.sym) {
-					if (kc != 0x6B && kc != 0x72 && kc != 0x74 && kc != 0x75) {
-						if (kc >= 0x80) HWQueueKeyboardEvent(0xE0);					// Shift
-						if (event.type == SDL_KEYUP) HWQueueKeyboardEvent(0xF0);	// Release
-						HWQueueKeyboardEvent(kc & 0x7F);							// Scan code.
-					}
+		return;
+	}
+	if (event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) {					// Handle other keys.
+		_GFXUpdateKeyRecord(event->key.keysym.sym,event->type == SDL_KEYDOWN);
+		LATHostEvent(event->key.timestamp); 										// Bytes queued are timed from here
+		for (int kc = 0;kc < 256;kc++) {
+			if (sdlKeySymbolList[kc] == event->key.keysym.sym) {
+				if (kc != 0x6B && kc != 0x72 && kc != 0x74 && kc != 0x75) {
+					if (kc >= 0x80) HWQueueKeyboardEvent(0xE0);						// Shift
+					if (event->type == SDL_KEYUP) HWQueueKeyboardEvent(0xF0);		// Release
+					HWQueueKeyboardEvent(kc & 0x7F);								// Scan code.
 				}
 			}
 		}
+		LATHostEvent(0);
+	}
+}
+
+static void _GFXMainLoop(void *arg) {
+	SDL_Event event;
+	#ifndef EMSCRIPTEN
+	if (isIdle) { 																	// Nothing happening, e.g. paused
+		if (SDL_WaitEventTimeout(&event,GFX_IDLE_TIMEOUT)) _GFXHandleEvent(&event);	// so sleep until there is.
 	}
+	#endif
+	while (SDL_PollEvent(&event)) {													// While events in event queue.
+		_GFXHandleEvent(&event);
+	}
+	int render = GFXXRender(mainSurface,-1);										// Ask app to render state.
+	isIdle = (render != 0 && surfaceChanged == 0); 									// Drew nothing, not just skipped
+	if (render && surfaceChanged) {
+		LONG64 startTime = STSTime();
+		SDL_UpdateWindowSurface(mainWindow);										// And update the main window.
+		STSAddTime(STS_TIME_PRESENT,startTime);
+		surfaceChanged = 0;
+	}
+}
+
+// *******************************************************************************************************************************
+//
+//		Sleep until the performance counter reaches the deadline. The OS sleep is used for all but the last part, which
+//		is spun, as sleeps can overshoot by the scheduler's granularity.
+//
+// *******************************************************************************************************************************
+
+void GFXSleepUntil(LONG64 deadline) {
+	LONG64 frequency = SDL_GetPerformanceFrequency();
+	for (;;) {
+		LONG64 now = SDL_GetPerformanceCounter();
+		if (now >= deadline) return;
+		LONG64 remaining = (deadline - now) * 1000000000ULL / frequency; 			// Nanoseconds to go
+		if (remaining <= GFX_SPIN_NS) continue; 									// Spin the last bit.
+		remaining -= GFX_SPIN_NS;
+		#if defined(__linux__)
+		struct timespec ts;
+		ts.tv_sec = remaining / 1000000000ULL;ts.tv_nsec = remaining % 1000000000ULL;
+		clock_nanosleep(CLOCK_MONOTONIC,0,&ts,NULL);
+		#elif defined(__unix__) || defined(__APPLE__)
+		struct timespec ts;
+		ts.tv_sec = remaining / 1000000000ULL;ts.tv_nsec = remaining % 1000000000ULL;
+		nanosleep(&ts,NULL);
+		#else
+		if (remaining >= 1000000) SDL_Delay(remaining / 1000000); 					// Milliseconds only
+		#endif
+	}
+}
+
+// *******************************************************************************************************************************
+//
+//				Clear to the background. Anything drawn after this is new, so the field cache starts again.
+//
+// *******************************************************************************************************************************
+
+void GFXClear(void) {
 	SDL_FillRect(mainSurface, NULL, 												// Draw the background.
 						SDL_MapRGB(mainSurface->format, RED(background),GREEN(background),BLUE(background)));
-	int render = GFXXRender(mainSurface,-1);										// Ask app to render state.
-	if (render) SDL_UpdateWindowSurface(mainWindow);								// And update the main window.
+	generation++;
+	surfaceChanged = -1;
+}
+
+int GFXGeneration(void) {
+	return generation;
 }
 
 // *******************************************************************************************************************************
@@ -149,6 +253,7 @@ void GFXCloseWindow(void) {
 
 void GFXRectangle(SDL_Rect *rc,int colour) {
 	SDL_FillRect(mainSurface,rc,SDL_MapRGB(mainSurface->format,RED(colour),GREEN(colour),BLUE(colour)));
+	surfaceChanged = -1;
 }
 
 // *******************************************************************************************************************************
@@ -159,27 +264,142 @@ void GFXRectangle(SDL_Rect *rc,int colour) {
 
 #include "font.h"
 
-void GFXCharacter(int xc,int yc,int character,int size,int colour,int back) {
+// *******************************************************************************************************************************
+//
+//		Glyphs are rasterised once for each size and colour into an atlas surface, 96 characters in a row, with a colour
+//		key for the unset pixels. A string is then one rectangle fill for the background and a blit per character.
+//
+// *******************************************************************************************************************************
 
-	Uint32 col = SDL_MapRGB(mainSurface->format,RED(colour),GREEN(colour),BLUE(colour));				
-	SDL_Rect rc;
-	if (back >= 0) {
-		Uint32 col2 = SDL_MapRGB(mainSurface->format,RED(back),GREEN(back),BLUE(back));				
-		rc.x = xc-size/2;rc.y = yc-size/2;rc.w = 6 * size;rc.h = 8*size;
-		SDL_FillRect(mainSurface,&rc,col2);
+struct _GFXAtlas {
+	int 			size,colour; 													// What it was drawn for
+	SDL_Surface 	*surface; 														// Rasterised glyphs (NULL unused)
+};
+
+static _GFXAtlas atlas[GFX_ATLAS_COUNT];
+static int nextAtlas = 0; 															// Next one to replace when full.
+
+static void _GFXFlushAtlas(void) {
+	for (int i = 0;i < GFX_ATLAS_COUNT;i++) {
+		if (atlas[i].surface != NULL) SDL_FreeSurface(atlas[i].surface);
+		atlas[i].surface = NULL;
+	}
+}
+
+static SDL_Surface *_GFXGetAtlas(int size,int colour) {
+	for (int i = 0;i < GFX_ATLAS_COUNT;i++) {
+		if (atlas[i].surface != NULL && atlas[i].size == size && atlas[i].colour == colour) return atlas[i].surface;
 	}
-	if (character < 32 || character >= 128) character = '?';						// Unknown character
-	character = character - 32;														// First font item is $20 (Space)
+	_GFXAtlas *a = &atlas[nextAtlas];nextAtlas = (nextAtlas+1) % GFX_ATLAS_COUNT;
+	if (a->surface != NULL) SDL_FreeSurface(a->surface);
+	a->size = size;a->colour = colour;
+	a->surface = SDL_CreateRGBSurfaceWithFormat(0,96*5*size,7*size,32,mainSurface->format->format);
+	int key = (colour == 0x000) ? 0xFFF : 0x000; 									// Anything but the glyph colour
+	Uint32 keyColour = SDL_MapRGB(a->surface->format,RED(key),GREEN(key),BLUE(key));
+	Uint32 col = SDL_MapRGB(a->surface->format,RED(colour),GREEN(colour),BLUE(colour));
+	SDL_FillRect(a->surface,NULL,keyColour);
+	SDL_SetColorKey(a->surface,SDL_TRUE,keyColour);
+	SDL_Rect rc;
 	rc.w = rc.h = size;																// Width and Height of pixel.
-	for (int x = 0;x < 5;x++) {														// 5 Across
-		rc.x = xc + x * size;
-		for (int y = 0;y < 7;y++) {													// 7 Down
-			rc.y = yc + y * size;
-			if (fontdata[character*5+x] & (0x01 << y)) {							// Is bit set ? (note inversion)
-				SDL_FillRect(mainSurface,&rc,col);									// If so, draw the pixel
+	for (int c = 0;c < 96;c++) {
+		for (int x = 0;x < 5;x++) {													// 5 Across
+			rc.x = (c * 5 + x) * size;
+			for (int y = 0;y < 7;y++) {												// 7 Down
+				rc.y = y * size;
+				if (fontdata[c*5+x] & (0x01 << y)) {								// Is bit set ? (note inversion)
+					SDL_FillRect(a->surface,&rc,col);								// If so, draw the pixel
+				}
 			}
 		}
 	}
+	return a->surface;
+}
+
+static void _GFXDrawString(int xc,int yc,const char *text,int size,int colour,int back) {
+	int length = strlen(text);
+	if (back >= 0) { 																// Background for the whole string
+		SDL_Rect rc;
+		rc.x = xc-size/2;rc.y = yc-size/2;rc.w = 6 * size * length;rc.h = 8*size;
+		SDL_FillRect(mainSurface,&rc,SDL_MapRGB(mainSurface->format,RED(back),GREEN(back),BLUE(back)));
+	}
+	SDL_Surface *glyphs = _GFXGetAtlas(size,colour);
+	SDL_Rect src,tgt;
+	src.y = 0;src.w = 5 * size;src.h = 7 * size;
+	tgt.y = yc;
+	for (int i = 0;i < length;i++) {
+		int character = text[i];
+		if (character < 32 || character >= 128) character = '?';					// Unknown character
+		if (character != ' ') {
+			src.x = (character - 32) * 5 * size;									// First font item is $20 (Space)
+			tgt.x = xc + i * 6 * size;tgt.w = src.w;tgt.h = src.h;
+			SDL_BlitSurface(glyphs,&src,mainSurface,&tgt);
+		}
+	}
+	surfaceChanged = -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		Fields. Text drawn at the same position since the last clear is remembered, and only redrawn if it has changed,
+//		erasing what was there first. So a static panel costs nothing to "redraw". Erasing forgets any other fields it
+//		overlaps, so they are drawn again next time. Fields drawn over each other should be cleared every frame.
+//
+// *******************************************************************************************************************************
+
+struct _GFXField {
+	int 	position; 																// (x << 16) | y, -1 unused
+	int 	generation; 															// Valid only for this generation
+	int 	size,colour,back;
+	char 	text[GFX_FIELD_TEXT];
+};
+
+static _GFXField fields[GFX_FIELD_COUNT];
+
+static void _GFXFieldRect(_GFXField *f,SDL_Rect *rc) { 							// Area its text covers
+	rc->x = (f->position >> 16) - f->size/2;rc->y = (f->position & 0xFFFF) - f->size/2;
+	rc->w = 6 * f->size * strlen(f->text);rc->h = 8 * f->size;
+}
+
+static void _GFXEraseField(_GFXField *f) {
+	SDL_Rect rc,other;
+	_GFXFieldRect(f,&rc);
+	for (int i = 0;i < GFX_FIELD_COUNT;i++) { 										// Forget the fields it overlaps.
+		if (&fields[i] == f || fields[i].generation != generation) continue;
+		_GFXFieldRect(&fields[i],&other);
+		if (SDL_HasIntersection(&rc,&other)) fields[i].generation = generation-1;
+	}
+	int colour = (f->back >= 0) ? f->back : background; 							// Its own background, if it had one.
+	SDL_FillRect(mainSurface,&rc,SDL_MapRGB(mainSurface->format,RED(colour),GREEN(colour),BLUE(colour)));
+}
+
+void GFXString(int xc,int yc,const char *text,int size,int colour,int back) {
+	int position = (xc << 16) | (yc & 0xFFFF);
+	if (strlen(text) >= GFX_FIELD_TEXT) { _GFXDrawString(xc,yc,text,size,colour,back);return; }
+	int slot = ((position * 2654435761U) >> 20) & (GFX_FIELD_COUNT-1);
+	for (int probe = 0;probe < 8;probe++) { 										// Find it, or a free/stale slot.
+		_GFXField *f = &fields[(slot+probe) & (GFX_FIELD_COUNT-1)];
+		if (f->generation != generation) {	 										// Not drawn since the clear.
+			f->position = position;f->generation = generation;
+			f->size = size;f->colour = colour;f->back = back;strcpy(f->text,text);
+			_GFXDrawString(xc,yc,text,size,colour,back);
+			return;
+		}
+		if (f->position == position) {
+			if (f->size == size && f->colour == colour && f->back == back && strcmp(f->text,text) == 0) return;
+			_GFXEraseField(f); 														// Erase the old text.
+			f->size = size;f->colour = colour;f->back = back;strcpy(f->text,text);
+			_GFXDrawString(xc,yc,text,size,colour,back);
+			return;
+		}
+	}
+	_GFXDrawString(xc,yc,text,size,colour,back); 									// Table crowded, just draw it.
+}
+
+void GFXCharacter(int xc,int yc,int character,int size,int colour,int back) {
+	char text[2];
+	text[0] = character;text[1] = '\0';
+	if (character == 0) text[0] = '?';
+	GFXString(xc,yc,text,size,colour,back);
 }
 
 // *******************************************************************************************************************************
@@ -196,20 +416,7 @@ void GFXDefineCharacter(int nChar,int b1,int b2,int b3,int b4,int b5) {
 		fontdata[nChar++] = b3;
 		fontdata[nChar++] = b4;
 		fontdata[nChar++] = b5;
-	}
-}
-
-// *******************************************************************************************************************************
-//
-//									Support Routine - Draw 5 x 7 bitmap font string
-//
-// *******************************************************************************************************************************
-
-void GFXString(int xc,int yc,const char *text,int size,int colour,int back) {
-	while (*text != '\0') {															// While more text
-		GFXCharacter(xc,yc,*text,size,colour,back);									// Draw text
-		text++;																		// Next character
-		xc = xc + 6 * size;															// Advance horizontally.
+		_GFXFlushAtlas(); 															// Glyphs need drawing again.
 	}
 }
 
@@ -220,10 +427,14 @@ void GFXString(int xc,int yc,const char *text,int size,int colour,int back) {
 // *******************************************************************************************************************************
 
 void GFXNumber(int xc,int yc,int number,int base,int width,int size,int colour,int back) {
-	if (width > 0) {
-		GFXNumber(xc,yc,number/base,base,width-1,size,colour,back);
-		GFXCharacter(xc + size*6*(width-1),yc,"0123456789ABCDEF"[number % base],size,colour,back);
+	char text[33];
+	if (width > 32) width = 32;
+	text[width] = '\0';
+	for (int i = width-1;i >= 0;i--) { 												// Least significant digit last
+		text[i] = "0123456789ABCDEF"[number % base];
+		number = number / base;
 	}
+	GFXString(xc,yc,text,size,colour,back);
 }
 
 // *******************************************************************************************************************************
@@ -387,90 +598,40 @@ int  GFXTimer(void) {
 
 // *******************************************************************************************************************************
 //
-//													Audio : 3 channel + noise.
+//						Audio : the SN76489 chips, stereo. The callback always runs them, so the queue of writes drains.
 //
 // *******************************************************************************************************************************
 
-const int AMPLITUDE = 9000;
-const int FREQUENCY = 44100;
-
-void audio_callback(void*, Uint8*, int);
-
-Beeper::Beeper()
-{ 
-}
-
-void Beeper::setup(void) {
-    SDL_AudioSpec desiredSpec;
-    SDL_zero(desiredSpec);
-    desiredSpec.freq = FREQUENCY;
-    desiredSpec.format = AUDIO_S16LSB;
-    desiredSpec.channels = 1;
-    desiredSpec.samples = 512;
-    desiredSpec.callback = audio_callback;
-    desiredSpec.userdata = this;
-
-    SDL_AudioSpec obtainedSpec;
-    dev = SDL_OpenAudioDevice(NULL,0,&desiredSpec, &obtainedSpec,0);
-    if (dev == 0) 
-    	printf("Couldn't open audio %s\n",SDL_GetError());
-    if (desiredSpec.format != obtainedSpec.format) 
-    	printf("Wrong format. %x %x\n",desiredSpec.format,obtainedSpec.format);
-    SDL_PauseAudioDevice(dev,0);
- 	noise = freq1 = freq2 = freq3 = 0;
-}
+static int audioMuted = 0;
 
-Beeper::~Beeper()
-{
-    SDL_CloseAudioDevice(dev);
+static void _GFXAudioCallback(void *userData,Uint8 *stream,int length) {
+	SNAudioRender((short *)stream,length/4);
+	if (audioMuted) memset(stream,0,length);
 }
 
-void Beeper::generateSamples(Sint16 *stream, int length)
-{
-    int i = 0;
-    for (int n = 0;n < length;n++) stream[n] = 0;
-    while (i < length) {
-    	if (freq1 != 0) {
-    		stream[i] += AMPLITUDE * ((((int)(v1*2/FREQUENCY)) % 2) ? -1 : 1);
-    	    v1 += freq1;
-        }
-    	if (freq2 != 0) {
-    		stream[i] += AMPLITUDE * ((((int)(v2*2/FREQUENCY)) % 2) ? -1 : 1);
-    	    v2 += freq2;
-        }
-    	if (freq3 != 0) {
-    		stream[i] += AMPLITUDE * ((((int)(v3*2/FREQUENCY)) % 2) ? -1 : 1);
-    	    v3 += freq3;
-        }
-        if (noise != 0) {
-        	stream[i] += AMPLITUDE * ((rand() & 1) ? -1 : 1);	
-        }
-        i++;
-    }
-}
-
-void Beeper::setFrequency(double f,int channel) {
-	if (channel == 0) noise = f;
-	if (channel == 1) freq1 = f;
-	if (channel == 2) freq2 = f;
-	if (channel == 3) freq3 = f;
-}
-
-void audio_callback(void *_beeper, Uint8 *_stream, int _length)
-{
-    Sint16 *stream = (Sint16*) _stream;
-    int length = _length / 2;
-    Beeper* beeper = (Beeper*) _beeper;
-    beeper->generateSamples(stream, length);
+static void _GFXOpenAudio(void) {
+	SDL_AudioSpec desiredSpec,obtainedSpec;
+	SDL_zero(desiredSpec);
+	desiredSpec.freq = SN_SAMPLE_RATE;
+	desiredSpec.format = AUDIO_S16SYS;
+	desiredSpec.channels = 2;
+	desiredSpec.samples = SNGetBufferSize();
+	desiredSpec.callback = _GFXAudioCallback;
+	SNReset(); 																		// Before the callback can run
+	audioDevice = SDL_OpenAudioDevice(NULL,0,&desiredSpec,&obtainedSpec,0); 		// No changes allowed, SDL converts
+	if (audioDevice == 0) {
+		printf("Couldn't open audio %s\n",SDL_GetError());
+		return;
+	}
+	SNAudioOpened(obtainedSpec.samples);
+	SDL_PauseAudioDevice(audioDevice,0);
 }
 
-void GFXSetFrequency(int freq,int channel) {
-	beeper.setFrequency(freq,channel);
+void GFXSetMute(int isMuted) {
+	audioMuted = isMuted;
+	SNSetMute(isMuted);
 }
 
 void GFXSilence(void) {
-	beeper.setFrequency(0,0);
-	beeper.setFrequency(0,1);
-	beeper.setFrequency(0,2);
-	beeper.setFrequency(0,3);
-}
\ No newline at end of file
+	SNSilence();
+}
@@ -45,6 +45,12 @@
 #define GFXISSHIFTKEY(x)	((x) == GFXKEY_SHIFT || (x) == GFXKEY_RSHIFT || (x) == GFXKEY_LSHIFT)
 #define GFXISCONTROLKEY(x)	((x) == GFXKEY_CONTROL)
 
+#define GFX_ATLAS_COUNT 	(16) 											// Rasterised font sizes/colours kept
+#define GFX_FIELD_COUNT 	(1024) 											// Text fields remembered (power of 2)
+#define GFX_FIELD_TEXT 		(48) 											// Longest text remembered.
+#define GFX_IDLE_TIMEOUT 	(100) 											// ms to wait for an event if a frame drew nothing.
+#define GFX_SPIN_NS 		(200000) 										// Spin, not sleep, for the last 0.2ms of a wait
+
 #define GRID(x,y) 			_GFXX(x),_GFXY(y)
 #define GRIDSIZE 			_GFXS()
 
@@ -57,6 +63,9 @@ void GFXStart(int autoStart);
 void GFXExit(void);
 void GFXCloseWindow(void);
 
+void GFXClear(void);
+void GFXSleepUntil(unsigned long long deadline);
+int  GFXGeneration(void);
 void GFXRectangle(SDL_Rect *rc,int colour);
 void GFXCharacter(int xc,int yc,int character,int size,int colour,int back);
 void GFXString(int xc,int yc,const char *text,int size,int colour,int back);
@@ -68,25 +77,12 @@ void GFXSetCharacterSize(int xSize,int ySize);
 void GFXDefineCharacter(int nChar,int b1,int b2,int b3,int b4,int b5);
 void GFXCloseOnDebug(void);
 void GFXSilence(void);
+void GFXSetMute(int isMuted);
+void GFXSetHeadless(int isOn);
+SDL_Surface *GFXGetSurface(void);
 
 int GFXXRender(SDL_Surface *surface,int autoStart);
-void GFXSetFrequency(int freq,int channel);
 
 int GFXReadJoystick0(void);
 
-class Beeper
-{
-private:
-    double noise;
-    double freq1,freq2,freq3;
-    double v1,v2,v3;
-    SDL_AudioDeviceID dev;
-public:
-    Beeper();
-    ~Beeper();
-    void setup(void);
-    void setFrequency(double freq,int channel);
-    void generateSamples(Sint16 *stream, int length);
-};
-
 #endif
@@ -0,0 +1,6 @@
+//
+//	 This file is automatically generated.
+//
+static int asciiToScanCode[] = { 0x0,0xec,0xeb,0x0,0xf1,0xe9,0xf4,0x0,0x66,0xd,0x0,0x0,0x0,0x5a,0xf2,0x0,0xf5,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x76,0x0,0x0,0x0,0x0,0x29,0x116,0x152,0x126,0x125,0x12e,0x13d,0x52,0x146,0x145,0x13e,0x155,0x41,0x4e,0x49,0x4a,0x45,0x16,0x1e,0x26,0x25,0x2e,0x36,0x3d,0x3e,0x46,0x14c,0x4c,0x141,0x55,0x149,0x14a,0x11e,0x11c,0x132,0x121,0x123,0x124,0x12b,0x134,0x133,0x143,0x13b,0x142,0x14b,0x13a,0x131,0x144,0x14d,0x115,0x12d,0x11b,0x12c,0x13c,0x12a,0x11d,0x122,0x135,0x11a,0x54,0x15d,0x5b,0x136,0x14e,0xe,0x1c,0x32,0x21,0x23,0x24,0x2b,0x34,0x33,0x43,0x3b,0x42,0x4b,0x3a,0x31,0x44,0x4d,0x15,0x2d,0x1b,0x2c,0x3c,0x2a,0x1d,0x22,0x35,0x1a,0x154,0x5d,0x15b,0x10e,0x0 };
+
+
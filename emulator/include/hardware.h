@@ -19,15 +19,55 @@ void HWWriteDisplay(WORD16 address,BYTE8 data);
 int HWGetScanCode(void);
 void HWWriteCharacter(WORD16 x,WORD16 y,BYTE8 ch);
 void HWQueueKeyboardEvent(int ps2code);
+void HWKeyboardSync(int isEndFrame);
 
+#define HW_TYPE_MAX_BYTES 	(8) 											// Most PS/2 bytes for one typed character
+#define HW_TYPE_DELAY 		(140) 											// Frames before type@<file> starts, let it boot
+#define HW_TYPE_LINE_DELAY 	(3) 											// Frames text must not change after a new line
+#define HW_TYPE_LINE_LIMIT 	(35) 											// Most frames to wait for that
+#define HW_TYPE_CHAR_CYCLES (10000) 										// Least cycles between typed characters
+#define HW_KEYBOARD_SYNCS 	(16) 											// Keyboard updates a frame
+
+void HWTypeText(const char *text,int length,int delayFrames);
+int  HWTypeFile(const char *fileName,int delayFrames);
+int  HWTypeNext(int *bytes);
+void HWTypeFrame(int textChanged);
+void HWTypeReset(void);
+int  HWTypeBusy(void);
+void HWSaveState(void);
+void HWRestoreState(void);
+
+#define HW_MATH 			(0xDE00) 										// Math coprocessor, operands
+#define HW_MATH_RESULTS 	(0xDE10) 										// ... results, read only
+#define HW_MATH_END 		(0xDE1F)
+
+#define HW_COUNTER 			(0xDEA0) 										// Cycle counter, 6 bytes, latched reading this
+#define HW_COUNTER_START 	(0xDEA8) 										// Write an accumulator's number to start it
+#define HW_COUNTER_STOP 	(0xDEA9) 										// ... to stop it
+#define HW_COUNTER_CLEAR 	(0xDEAA) 										// ... to clear and stop it
+#define HW_ACCUMULATORS 	(0xDEB0) 										// Cycles while started, 4 bytes each
+#define HW_COUNTERS 		(4)
+
+#define IO_MEMORY_SIZE 		(4*0x4000) 										// The four I/O pages
+
+#define IO_BLOCK_SIZE 		(16) 											// Device handlers cover blocks this size
+
+typedef BYTE8 (*IOReadHandler)(BYTE8 page,WORD16 address);
+typedef void (*IOWriteHandler)(BYTE8 page,WORD16 address,BYTE8 data);
+
+void IORegisterDevice(BYTE8 page,WORD16 from,WORD16 to,IOReadHandler read,IOWriteHandler write);
 BYTE8 IOReadMemory(BYTE8 page,WORD16 address);
 void IOWriteMemory(BYTE8 page,WORD16 address,BYTE8 data);
 BYTE8 IOReadSource(void);
+BYTE8 *IOAccessMemory(void);
 
 BYTE8 HWReadKeyboardHardware(WORD16 address);
 void HWWriteKeyboardHardware(WORD16 address,BYTE8 data);
 void HWResetKeyboardHardware(void);
 void HWKeyboardHardwareDequeue(int key);
 int HWCheckKeyboardInterruptEnabled(void);
+int HWKeyboardHardwareEmpty(void);
+void HWSaveKeyboardHardware(void);
+void HWRestoreKeyboardHardware(void);
 
 #endif
\ No newline at end of file
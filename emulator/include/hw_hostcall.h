@@ -0,0 +1,42 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		hw_hostcall.h
+//		Purpose:	Host call registers, services from the host for guest programs (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _HOSTCALL_H
+#define _HOSTCALL_H
+
+#define HCL_BASE 			(0xDE80) 												// Registers, I/O page 0, to $DE9F
+#define HCL_COMMAND 		(0xDE80) 												// Writing this does the call
+#define HCL_STATUS 			(0xDE81) 												// 0 if done, unchanged if not enabled
+#define HCL_ADDRESS 		(0xDE82) 												// Physical address, 3 bytes
+#define HCL_LENGTH 			(0xDE85) 												// Length, 3 bytes
+#define HCL_NAME 			(0xDE88) 												// Physical address of a file name, 3 bytes
+#define HCL_TIMER 			(0xDE90) 												// Microseconds, 8 bytes
+
+#define HCL_PRINT 			(1) 													// Commands : string at address to stdout
+#define HCL_WRITE 			(2) 													// length bytes at address to stdout
+#define HCL_LOAD 			(3) 													// File to address, length is set (limit if not 0)
+#define HCL_SAVE 			(4) 													// length bytes at address to file
+#define HCL_READ_TIMER 		(5) 													// Host time to the timer registers
+#define HCL_EXIT 			(6) 													// Exit, status is the low byte of length
+
+#define HCL_OK 				(0) 													// Status values
+#define HCL_BAD_COMMAND 	(1)
+#define HCL_BAD_ADDRESS 	(2)
+#define HCL_BAD_NAME 		(3) 													// Must be relative, no ".."
+#define HCL_FILE_ERROR 		(4)
+
+#define HCL_MAX_NAME 		(256)
+
+void HCLEnable(void);
+void HCLCommand(BYTE8 *registers,BYTE8 *memory);
+void HCLEndRun(void);
+
+#endif
@@ -0,0 +1,72 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		hw_sn76489.h
+//		Purpose:	SN76489 sound chips (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _SN76489_H
+#define _SN76489_H
+
+#define SN_CLOCK 			(111563*32) 											// Chip clock, about 3.57MHz
+#define SN_SAMPLE_RATE 		(44100)
+#define SN_CYCLE_RATE 		(CYCLE_RATE) 											// CPU cycles a second
+#define SN_FRAME_CYCLES 	(SN_CYCLE_RATE/FRAME_RATE) 								// CPU cycles a frame
+
+#define SN_VOLUME 			(7000) 													// Loudest channel, four fit in 16 bits
+#define SN_KERNEL_WIDTH 	(16) 													// Band limited step, samples
+#define SN_KERNEL_PHASES 	(64) 													// Step positions within a sample
+#define SN_MAX_RENDER 		(1024) 													// Samples made in one go
+
+#define SN_QUEUE_SIZE 		(4096) 													// Register writes waiting (power of 2)
+#define SN_LATENCY 			(2*SN_FRAME_CYCLES) 									// Sound plays this far behind the CPU
+#define SN_MAX_LAG 			(8*SN_FRAME_CYCLES) 									// Further out than this, resynchronise
+
+#define SN_DEFAULT_BUFFER 	(512) 													// Sound card buffer, samples
+#define SN_RING_SIZE 		(16384) 												// audiosync samples waiting (power of 2)
+#define SN_TARGET_BUFFERS 	(2) 													// audiosync keeps this many buffers waiting
+#define SN_MAX_ADJUST 		(328) 													// Most the rate changes, 0.5% in 16.16
+#define SN_PACE_TIMEOUT 	(250) 													// ms waiting before giving up on the card
+
+struct _SNChip {
+	int 	latch; 																	// Register being written, 0-7
+	int 	tone[3]; 																// 10 bit tone periods
+	int 	noise; 																	// Noise control, 3 bits
+	int 	attenuation[4]; 														// 0 (loudest) - 15 (off)
+	LONG64 	step[4]; 																// Phase added each sample, 32 bit fraction
+	LONG64 	phase[4]; 																// Toggles when the fraction overflows
+	int 	output[4]; 																// Square wave / noise flip flop output
+	int 	level[4]; 																// Level being output
+	int 	lfsr; 																	// Noise shift register
+	int 	noiseOut; 																// Bit 0 of it when last shifted
+};
+
+struct _SNEngine {
+	struct _SNChip chip[2]; 														// $D600 left, $D610 right
+	int 	buffer[2][SN_MAX_RENDER+SN_KERNEL_WIDTH]; 								// Band limited level changes
+	int 	integrator[2]; 															// Running sum of them
+};
+
+void SNEngineReset(struct _SNEngine *e);
+void SNEngineWrite(struct _SNEngine *e,int chip,int data);
+void SNEngineRender(struct _SNEngine *e,short *stereo,int samples);
+
+void SNReset(void);
+void SNWrite(int chip,int data);
+void SNSync(void);
+void SNSilence(void);
+void SNAudioRender(short *stereo,int samples);
+
+void SNSetAudioSync(int isOn);
+void SNSetBufferSize(int samples);
+int  SNGetBufferSize(void);
+void SNAudioOpened(int samples);
+void SNSetMute(int isMuted);
+int  SNAudioPace(void);
+void SNReport(void);
+
+#endif
@@ -0,0 +1,36 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_capture.h
+//		Purpose:	Capturing the display and sound to files, in emulated time (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _CAPTURE_H
+#define _CAPTURE_H
+
+#define CAP_WIDTH 			(640) 													// Display captured, without the border
+#define CAP_HEIGHT 			(480)
+#define CAP_SCALE 			(2) 													// Window pixels to a display pixel
+#define CAP_QUEUE 			(8) 													// Frames waiting for the writer thread
+#define CAP_FRAME_RATE 		(FRAME_RATE)
+
+#define CAP_CYCLE_RATE 		(CYCLE_RATE) 											// CPU cycles a second
+#define CAP_SAMPLE_RATE 	(44100) 												// WAV sample rate
+#define CAP_AUDIO_BUFFER 	(4096) 													// Stereo samples buffered before writing
+
+#define CAP_RGBA 			(0) 													// Frame formats
+#define CAP_PPM 			(1)
+#define CAP_PNG 			(2)
+#define CAP_Y4M 			(3)
+
+int  CAPOpen(const char *fileName);
+int  CAPOpenAudio(const char *fileName);
+void CAPSoundWrite(int chip,int data);
+void CAPEndFrame(void);
+void CAPClose(void);
+
+#endif
@@ -14,6 +14,11 @@
 #ifndef _DEBUG_SYS_H
 #define _DEBUG_SYS_H
 #include "sys_processor.h"
+#include "sys_stats.h"
+#include "sys_heatmap.h"
+#include "sys_disasm.h"
+#include "sys_runahead.h"
+#include "hw_sn76489.h"
 
 #define WIN_TITLE 		"Simple 256 Junior Emulator"								// Initial Window stuff
 #define WIN_WIDTH		(42*8*4)
@@ -28,6 +33,7 @@
 
 #define DEBUG_CPURENDER(x) 	DBGXRender(x,0)											// Render the debugging display
 #define DEBUG_VDURENDER(x)	DBGXRender(x,1)											// Render the game display etc.
+#define DEBUG_RUNAHEAD(x) 	RAHRender(x) 											// Render it some frames ahead, 0 if not.
 
 #define DEBUG_RESET() 		CPUReset()												// Reset the CPU / Hardware.
 #define DEBUG_HOMEPC()		((CPUGetStatus()->pc) & 0xFFFF) 						// Get PC Home Address (e.g. current PCTR value)
@@ -41,6 +47,18 @@
 
 #define DEBUG_KEYMAP(k,r)	(k)
 
+#define DEBUG_TIMER() 		STSTime() 												// Host timer, for statistics.
+#define DEBUG_TIMECPU(t) 	STSAddTime(STS_TIME_CPU,t) 								// Charge time to running the CPU
+#define DEBUG_TIMEWAIT(t) 	STSAddTime(STS_TIME_WAIT,t) 							// Charge time to frame pacing.
+#define DEBUG_PACEAUDIO() 	SNAudioPace() 											// Paced by the sound card, 0 if not.
+#define DEBUG_OVERLAY() 	STSRenderOverlay() 										// Draw the statistics overlay, if on
+#define DEBUG_TOGGLEOVERLAY() STSToggleOverlay() 									// Toggle it.
+#define DEBUG_OVERLAYSHOWN() STSOverlayShown() 										// Non zero if it is on.
+#define DEBUG_HEATRESET() 	HMPReset() 												// Clear the memory heatmap
+#define DEBUG_HEATEXPORT() 	HMPExport() 											// Write it out.
+#define DEBUG_PREVIOUS(a) 	DISPreviousInstruction(a) 								// Scroll code display back
+#define DEBUG_NEXT(a) 		DISNextInstruction(a) 									// and forward.
+
 void DBGXRender(int *address,int isRunMode);										// Render the debugger screen.
 BYTE8 DRVGFXHandler(BYTE8 key,BYTE8 isRunMode);
 
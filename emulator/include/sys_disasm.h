@@ -0,0 +1,37 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_disasm.h
+//		Purpose:	Cached, symbol aware disassembly index (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _DISASM_H
+#define _DISASM_H
+
+#define DIS_PAGES 			(MEMSIZE >> 13) 										// 8k physical pages
+#define DIS_LINE_CACHE 		(256) 													// Decoded lines kept (power of 2)
+#define DIS_TEXT_SIZE 		(16) 													// Characters of disassembly shown
+
+#define DIS_MONITOR_SYMBOLS "build/__newmonitor.lst" 								// Listings written by the kernel build
+#define DIS_LOCKOUT_SYMBOLS "build/__lockout.lst"
+
+extern LONG32 disPageVersion[DIS_PAGES];
+
+#define DISPageWritten(physical) 	disPageVersion[(physical) >> 13]++ 				// Invalidate cache for a page
+
+void DISReset(void);
+void DISInvalidateAll(void);
+void DISWantPageVersions(void);
+int  DISPageVersionsWanted(void);
+int  DISLoadSymbols(const char *fileName);
+const char *DISSymbol(WORD16 address);
+int  DISFindSymbol(const char *name,int *physical,int maxCount);
+const char *DISDisassemble(WORD16 address,int *length);
+WORD16 DISNextInstruction(WORD16 address);
+WORD16 DISPreviousInstruction(WORD16 address);
+
+#endif
@@ -0,0 +1,34 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_flatcpu.h
+//		Purpose:	The 65C02 core on a flat 64k of RAM, no F256 hardware (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _FLATCPU_H
+#define _FLATCPU_H
+
+struct FCPState {
+	WORD16 	pc;
+	BYTE8 	a,x,y,s,p; 																// P as pushed, bits 4 and 5 set
+};
+
+struct FCPAccess {
+	WORD16 	address;
+	BYTE8 	data,isWrite;
+};
+
+void   FCPReset(void);
+BYTE8 *FCPMemory(void);
+void   FCPGetState(struct FCPState *st);
+void   FCPSetState(struct FCPState *st);
+int    FCPStep(void);
+int    FCPStepLogged(struct FCPAccess *log,int maxAccesses,int *count);
+LONG64 FCPRun(LONG64 cycles,WORD16 stopAddress);
+void   FCPInterrupt(int isNMI);
+
+#endif
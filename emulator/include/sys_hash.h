@@ -0,0 +1,24 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_hash.h
+//		Purpose:	Hash of everything that makes up the display, without drawing it (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _HASH_H
+#define _HASH_H
+
+#define HSH_GRAPHICS_PAGES 	(0x40000 >> 13) 										// Vicky sees the first 256k of RAM
+
+void HSHPaletteWritten(void);
+void HSHInvalidate(void);
+LONG64 HSHDisplayHash(void);
+int  HSHOpen(const char *fileName);
+void HSHEndFrame(void);
+void HSHClose(void);
+
+#endif
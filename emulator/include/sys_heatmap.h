@@ -0,0 +1,44 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_heatmap.h
+//		Purpose:	Physical memory read/write/execute heatmap (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _HEATMAP_H
+#define _HEATMAP_H
+
+#define HMP_EXPORT_FILE 	"heatmap.csv"
+
+#define HMP_READ 			(0) 													// Counter types
+#define HMP_WRITE 			(1)
+#define HMP_EXECUTE 		(2)
+
+#define HMP_RAM_BLOCKS 		(MEMSIZE >> 8) 											// 256 byte blocks of RAM
+#define HMP_IO_BLOCKS 		(4 * (0x2000 >> 8)) 									// 256 byte blocks of the 4 I/O pages
+#define HMP_BLOCKS 			(HMP_RAM_BLOCKS+HMP_IO_BLOCKS)
+#define HMP_PAGES 			(MEMSIZE >> 13) 										// 8k physical pages
+
+#define HMP_THRASH 			(32) 													// MMU writes a frame that count as thrash
+
+extern LONG64 hmpCount[3][HMP_BLOCKS];
+
+#define HMPCount(t,physical) 	hmpCount[t][(physical) >> 8]++ 						// Count RAM access at physical address
+#define HMPCountIO(t,page,a) 	hmpCount[t][HMP_RAM_BLOCKS+(page)*32+(((a) >> 8) & 0x1F)]++
+
+void HMPReset(void);
+void HMPRemap(int slot);
+void HMPEndFrame(void);
+int  HMPSlotActivity(int slot);
+void HMPEnableExport(void);
+int  HMPIsCounting(void);
+void HMPExport(void);
+void HMPExportOnExit(void);
+void HMPRender(int x,int y,int w,int h);
+int  HMPRenderStatus(char *buffer);
+
+#endif
@@ -0,0 +1,34 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_hle.h
+//		Purpose:	High level emulation of hot monitor routines (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _HLE_H
+#define _HLE_H
+
+#define HLE_MAX_INSTALLED 	(8) 													// Hooked physical addresses
+#define HLE_CHECK_LIMIT 	(1000000) 												// Cycles the 6502 version may take (hlecheck)
+#define HLE_MAX_REPORT 		(20) 													// Check failures described in full
+
+struct HLERegisters {
+	WORD16 	pc;
+	BYTE8 	a,x,y,s,p; 																// P as pushed
+};
+
+extern BYTE8 hleOffsets[0x2000]; 													// Non zero if a hook is at this page offset
+
+#define HLEMightHook(address) 	hleOffsets[(address) & 0x1FFF]
+
+int  HLEInstall(int isChecking);
+int  HLEFind(int physical);
+int  HLECall(int hook,struct HLERegisters *r);
+void HLECheckResult(int hook,const char *differences);
+int  HLEReport(void);
+
+#endif
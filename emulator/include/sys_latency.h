@@ -0,0 +1,44 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_latency.h
+//		Purpose:	Keyboard input to guest latency measurement (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _LATENCY_H
+#define _LATENCY_H
+
+#define LAT_CSV_FILE 		"latency.csv"
+
+#define LAT_HOST 			(0) 													// Stages a PS/2 byte goes through
+#define LAT_QUEUED 			(1) 													// HWQueueKeyboardEvent
+#define LAT_FIFO 			(2) 													// HWSync moves it to the FIFO
+#define LAT_IRQ 			(3) 													// Keyboard interrupt raised
+#define LAT_READ 			(4) 													// Guest reads it from $D642
+#define LAT_STAGES 			(5)
+
+#define LAT_RECORDS 		(8192) 													// Bytes remembered (power of 2)
+
+#define LAT_TEST_START 		(140) 													// Frames before typing, let it boot
+#define LAT_TEST_BURSTS 	(4) 													// Bursts typed
+#define LAT_TEST_KEYS 		(16) 													// Keys in each burst
+#define LAT_TEST_GAP 		(70) 													// Frames between bursts
+#define LAT_TEST_SETTLE 	(140) 													// Frames after, before exiting
+
+void LATEnable(void);
+void LATReset(void);
+void LATStartTest(double keysPerSecond);
+void LATSpeculating(int isOn);
+void LATHostEvent(LONG32 timestamp);
+void LATQueued(int code,int isAccepted);
+void LATFifo(int isAccepted);
+void LATInterrupt(void);
+void LATRead(void);
+void LATTestFrame(void);
+void LATReport(void);
+
+#endif
@@ -0,0 +1,23 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_loader.h
+//		Purpose:	Load images, raw, PGX or PGZ, cached over resets (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _LOADER_H
+#define _LOADER_H
+
+#define LDR_MAX_CACHED 		(32) 													// Files kept in memory
+
+#define LDR_OK 				(1) 													// LDRLoad returns
+#define LDR_NO_FILE 		(0)
+#define LDR_BAD_FORMAT 		(-1) 													// Bad PGX/PGZ, or outside memory
+
+int  LDRLoad(const char *fileName,int loadAddress,int *startAddress);
+
+#endif
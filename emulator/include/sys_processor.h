@@ -14,6 +14,9 @@
 
 #define MEMSIZE 		(0x100000)													// 1Mb of Memory.
 
+#define CYCLE_RATE 		(6290*1000)													// Cycles per second (6.29Mhz)
+#define FRAME_RATE		(70)														// Frames per second
+
 #define PAGE_MONITOR 	(MONITOR_ADDRESS >> 13) 									// Page the boot ROM is loaded into.
 #define PAGE_BASIC 		(BASIC_ADDRESS >> 13) 										// Page(s) the basic ROM is loaded into.
 #define PAGE_SOURCE  	(SOURCE_ADDRESS >> 13) 										// Page the source is loaded into.
@@ -22,6 +25,7 @@
 typedef unsigned short WORD16;														// 8 and 16 bit types.
 typedef unsigned char  BYTE8;
 typedef unsigned int   LONG32;														// 32 bit type.
+typedef unsigned long long LONG64;													// 64 bit type.
 
 #define DEFAULT_BUS_VALUE (0xFF)													// What's on the bus if it's not memory.
 
@@ -32,13 +36,17 @@ BYTE8 CPUExecuteInstruction(void);
 BYTE8 CPUWriteKeyboard(BYTE8 pattern);
 BYTE8 CPUReadMemory(WORD16 address);
 BYTE8 *CPUAccessMemory(void);
+int CPUMapAddress(WORD16 address);
+BYTE8 CPUPeekMemory(WORD16 address);
+LONG64 CPUGetCycleCount(void);
+LONG64 CPUGetInstructionCount(void);
 
 void CPUInterruptMaskable(void);
 
 typedef struct __CPUSTATUS {
 	int a,x,y,sp,pc;
 	int carry,zero,sign,interruptDisable,decimal,brk,overflow,status;
-	int cycles;		
+	LONG64 cycles;		
 	int mapping[8];		
 } CPUSTATUS;
 
@@ -50,4 +58,10 @@ void CPUEndRun(void);
 void CPULoadBinary(char *fileName);
 void CPUExit(void);
 void CPUSaveArguments(int argc,char *argv[]);
+void CPUSaveState(void);
+void CPURestoreState(void);
+
+struct FCPState;
+void CPUVectorSetUp(void);
+int  CPUVectorStep(struct FCPState *st);
 #endif
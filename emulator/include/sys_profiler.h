@@ -0,0 +1,29 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_profiler.h
+//		Purpose:	6502 Profiler (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#define PRF_TOP_COUNT 	(40) 														// Entries in the hotspot tables.
+#define PRF_MAX_DEPTH 	(256) 														// Deepest call stack tracked.
+
+#define PRF_FOLDED_FILE "profile.folded" 											// Folded stacks, for flamegraph.pl
+#define PRF_REPORT_FILE "profile.txt" 												// Hotspot tables.
+
+void PRFStart(void);
+int  PRFIsEnabled(void);
+void PRFInstruction(int address,int cycles);
+void PRFCall(int target,BYTE8 sp);
+void PRFInterrupt(int target,BYTE8 sp);
+void PRFReturn(BYTE8 sp);
+void PRFWriteReport(void);
+
+#endif
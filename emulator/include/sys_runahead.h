@@ -0,0 +1,23 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_runahead.h
+//		Purpose:	Input run-ahead, and input to display latency (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _RUNAHEAD_H
+#define _RUNAHEAD_H
+
+#define RAH_MAX_FRAMES 		(8) 													// Most frames that can be run ahead
+#define RAH_TIMEOUT 		(500) 													// ms before a key is taken as unseen
+
+void RAHSetFrames(int frames);
+int  RAHRender(int *address);
+void RAHKeyEvent(void);
+void RAHReport(void);
+
+#endif
@@ -0,0 +1,30 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_script.h
+//		Purpose:	Script runner, for testing without a keyboard or window (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _SCRIPT_H
+#define _SCRIPT_H
+
+#define SCR_MAX_TEXT 		(256) 													// Longest text in a command
+#define SCR_WAIT_TIMEOUT 	(700) 													// Default frames for wait (10s)
+
+#define SCR_TYPE 			(0) 													// Commands
+#define SCR_KEY 			(1)
+#define SCR_FRAMES 			(2)
+#define SCR_WAIT 			(3)
+#define SCR_ASSERT 			(4)
+#define SCR_SCREEN 			(5)
+#define SCR_SETTLE 			(6)
+
+int  SCRLoad(const char *fileName);
+void SCRFrame(void);
+void SCREnd(void);
+
+#endif
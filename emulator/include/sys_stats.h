@@ -0,0 +1,62 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_stats.h
+//		Purpose:	Hot path statistics and performance overlay (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _STATS_H
+#define _STATS_H
+
+#define STS_JSON_FILE 	"stats.json"
+
+#define STS_FRAMES 			(0) 													// Counters
+#define STS_MMU_CONTROL 	(1) 													// Writes to $0000
+#define STS_IO_CONTROL 		(2) 													// Writes to $0001
+#define STS_MMU_EDIT 		(3) 													// Writes to the edited LUT
+#define STS_DMA_BYTES 		(4) 													// Bytes moved by DMA
+#define STS_COUNTERS 		(5)
+
+#define STS_TIME_CPU 		(0) 													// Host time accumulators
+#define STS_TIME_WAIT 		(1) 													// Frame pacing
+#define STS_TIME_BACKGROUND (2) 													// Render layers
+#define STS_TIME_TILEMAP 	(3)
+#define STS_TIME_BITMAP 	(4)
+#define STS_TIME_SPRITE 	(5)
+#define STS_TIME_TEXT 		(6)
+#define STS_TIME_PRESENT 	(7) 													// Window update
+#define STS_TIMERS 			(8)
+
+#define STS_DEV_VICKY 		(0) 													// I/O device ranges
+#define STS_DEV_SOUND 		(1)
+#define STS_DEV_KEYBOARD 	(2)
+#define STS_DEV_TIMER 		(3)
+#define STS_DEV_INTERRUPT 	(4)
+#define STS_DEV_RNG 		(5)
+#define STS_DEV_SPRITE 		(6)
+#define STS_DEV_TEXTLUT 	(7)
+#define STS_DEV_JOYSTICK 	(8)
+#define STS_DEV_DMA 		(9)
+#define STS_DEV_OTHER 		(10)
+#define STS_DEV_PAGE1 		(11) 													// Font and graphics LUTs
+#define STS_DEV_TEXT 		(12)
+#define STS_DEV_COLOUR 		(13)
+#define STS_DEVICES 		(14)
+
+void STSReset(void);
+void STSEnableJSON(void);
+int  STSIsCounting(void);
+void STSAdd(int counter,LONG64 n);
+void STSIOAccess(BYTE8 page,WORD16 address,int isWrite);
+LONG64 STSTime(void);
+void STSAddTime(int timer,LONG64 startTime);
+void STSToggleOverlay(void);
+int  STSOverlayShown(void);
+void STSRenderOverlay(void);
+void STSWriteJSON(void);
+
+#endif
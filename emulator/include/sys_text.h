@@ -0,0 +1,42 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_text.h
+//		Purpose:	Reading the text display as host text, and hashing it (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _TEXT_H
+#define _TEXT_H
+
+#include <stdio.h>
+
+#define TXT_MAX_COLUMNS 	(80) 													// Largest text display
+#define TXT_MAX_ROWS 		(60)
+
+#define TXT_FNV_BASIS 		(14695981039346656037ULL) 								// 64 bit FNV-1a
+#define TXT_FNV_PRIME 		(1099511628211ULL)
+
+#define TXT_BLOCKS 			(0x2000 >> 4) 											// 16 byte blocks of a text page
+
+extern LONG32 txtRowVersion[TXT_MAX_ROWS]; 											// Bumped when a row has been written
+extern BYTE8 txtBlockWritten[TXT_BLOCKS]; 											// Set on writes, made into rows later
+extern int txtAnyWritten;
+
+#define TXTWritten(a) 		{ txtBlockWritten[((a) >> 4) & (TXT_BLOCKS-1)] = 1;txtAnyWritten = -1; }
+
+void TXTInvalidate(void);
+int  TXTColumns(void);
+int  TXTRows(void);
+void TXTRow(int row,char *buffer);
+void TXTColourRow(int row,char *buffer);
+int  TXTFind(const char *text,LONG32 *versions);
+LONG64 TXTHash(void);
+void TXTDump(FILE *f,int withColours);
+void TXTDumpOnExit(const char *fileName);
+void TXTEndRun(void);
+
+#endif
@@ -0,0 +1,32 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_trace.h
+//		Purpose:	Binary execution and bus trace (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#define TRC_RING_SIZE 	(1 << 22) 													// Ring size in 64 bit words (power of 2)
+#define TRC_MAX_EVENTS 	(32) 														// Most words one instruction can need.
+
+#define TRC_READ 		(0) 														// Bus access types.
+#define TRC_WRITE 		(1)
+#define TRC_IOREAD 		(2)
+#define TRC_IOWRITE 	(3)
+
+#define TRC_MAGIC 		"F256TRC\x01" 												// File header.
+
+int  TRCOpen(const char *fileName);
+void TRCBeginInstruction(LONG64 cycle,WORD16 pc,BYTE8 a,BYTE8 x,BYTE8 y,BYTE8 s,BYTE8 p);
+void TRCEndInstruction(BYTE8 opcode);
+void TRCCancelInstruction(void);
+void TRCBusAccess(int type,WORD16 address,int physical,BYTE8 data);
+void TRCClose(void);
+
+#endif
@@ -0,0 +1,53 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_vectors.h
+//		Purpose:	CPU conformance, single step test vectors run on every core variant (header)
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#ifndef _VECTORS_H
+#define _VECTORS_H
+
+#define VEC_MAGIC 			"F256VEC\x01" 											// Binary vector file header
+#define VEC_NAME 			(16) 													// Characters of a vector's name kept
+#define VEC_MAX_RAM 		(16) 													// RAM bytes in a state
+#define VEC_MAX_WRITES 		(8) 													// Writes in one instruction
+#define VEC_MAX_ACCESSES 	(32) 													// Bus accesses logged
+#define VEC_MAX_THREADS 	(64)
+#define VEC_MAX_REPORT 		(20) 													// Failures described in full
+
+#define VEC_BAD_PC 			(0x001) 												// What didn't match
+#define VEC_BAD_A 			(0x002)
+#define VEC_BAD_X 			(0x004)
+#define VEC_BAD_Y 			(0x008)
+#define VEC_BAD_S 			(0x010)
+#define VEC_BAD_P 			(0x020)
+#define VEC_BAD_RAM 		(0x040)
+#define VEC_BAD_CYCLES 		(0x080)
+#define VEC_BAD_WRITES 		(0x100)
+#define VEC_BAD_COUNT 		(9)
+
+struct VECState {
+	WORD16 	pc;
+	BYTE8 	s,a,x,y,p;
+	int 	ramCount;
+	WORD16 	ramAddress[VEC_MAX_RAM];
+	BYTE8 	ramData[VEC_MAX_RAM];
+};
+
+struct VECVector {
+	char 	name[VEC_NAME];
+	struct VECState initial,final;
+	int 	cycles; 																// Bus cycles the instruction takes
+	int 	writeCount; 															// Writes, in order
+	WORD16 	writeAddress[VEC_MAX_WRITES];
+	BYTE8 	writeData[VEC_MAX_WRITES];
+};
+
+int VECRun(const char *path);
+
+#endif
@@ -0,0 +1,9 @@
+//
+//	 This file is automatically generated.
+//
+static int sdlKeySymbolList[] = { 0,SDLK_F9,0,SDLK_F5,SDLK_F3,SDLK_F1,SDLK_F2,SDLK_F12,0,SDLK_F10,SDLK_F8,SDLK_F6,SDLK_F4,SDLK_TAB,SDLK_BACKQUOTE,0,0,SDLK_LALT,SDLK_LSHIFT,0,SDLK_LCTRL,SDLK_q,SDLK_1,0,0,0,SDLK_z,SDLK_s,SDLK_a,SDLK_w,SDLK_2,0,0,SDLK_c,SDLK_x,SDLK_d,SDLK_e,SDLK_4,SDLK_3,0,0,SDLK_SPACE,SDLK_v,SDLK_f,SDLK_t,SDLK_r,SDLK_5,0,0,SDLK_n,SDLK_b,SDLK_h,SDLK_g,SDLK_y,SDLK_6,0,0,0,SDLK_m,SDLK_j,SDLK_u,SDLK_7,SDLK_8,0,0,SDLK_COMMA,SDLK_k,SDLK_i,SDLK_o,SDLK_0,SDLK_9,0,0,SDLK_PERIOD,SDLK_SLASH,SDLK_l,SDLK_SEMICOLON,SDLK_p,SDLK_MINUS,0,0,0,SDLK_QUOTE,0,SDLK_LEFTBRACKET,SDLK_EQUALS,0,0,0,SDLK_RSHIFT,SDLK_RETURN,SDLK_RIGHTBRACKET,0,SDLK_BACKSLASH,0,0,0,0,0,0,0,0,SDLK_BACKSPACE,0,0,0,0,SDLK_LEFT,0,0,0,0,0,0,SDLK_DOWN,0,SDLK_RIGHT,SDLK_UP,SDLK_ESCAPE,0,SDLK_F11,0,0,0,0,0,0,0,0,0,0,SDLK_F7,0,0,0,0,0,0,0,0,0,0,0,0,0,SDLK_RALT,0,0,SDLK_RCTRL,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,SDLK_END,0,SDLK_LEFT,SDLK_HOME,0,0,0,SDLK_INSERT,SDLK_DELETE,SDLK_DOWN,0,SDLK_RIGHT,SDLK_UP,0,0,0,0,SDLK_PAGEDOWN,0,0,SDLK_PAGEUP,0,0 };
+
+
+static int asciiToScanCode[] = { 0x0,0xec,0xeb,0x0,0xf1,0xe9,0xf4,0x0,0x66,0xd,0x0,0x0,0x0,0x5a,0xf2,0x0,0xf5,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x76,0x0,0x0,0x0,0x0,0x29,0x116,0x152,0x126,0x125,0x12e,0x13d,0x52,0x146,0x145,0x13e,0x155,0x41,0x4e,0x49,0x4a,0x45,0x16,0x1e,0x26,0x25,0x2e,0x36,0x3d,0x3e,0x46,0x14c,0x4c,0x141,0x55,0x149,0x14a,0x11e,0x11c,0x132,0x121,0x123,0x124,0x12b,0x134,0x133,0x143,0x13b,0x142,0x14b,0x13a,0x131,0x144,0x14d,0x115,0x12d,0x11b,0x12c,0x13c,0x12a,0x11d,0x122,0x135,0x11a,0x54,0x0,0x5b,0x136,0x14e,0xe,0x1c,0x32,0x21,0x23,0x24,0x2b,0x34,0x33,0x43,0x3b,0x42,0x4b,0x3a,0x31,0x44,0x4d,0x15,0x2d,0x1b,0x2c,0x3c,0x2a,0x1d,0x22,0x35,0x1a,0x154,0x5d,0x15b,0x10e,0x0 };
+
+
@@ -9,7 +9,7 @@
 # *******************************************************************************************
 # *******************************************************************************************
 
-import re 
+import re,sys
 
 # *******************************************************************************************
 #
@@ -41,5 +41,35 @@ for s in rawData:
 
 table = ",".join(keyToScan)
 
+# *******************************************************************************************
+#
+#		Creates a table that maps ASCII (0-127) to keycodes, bit 8 set if shifted, for
+#		typing text. Control characters come from the [n] values. This is written instead
+#		of the keycode table if the argument 'ascii' is given.
+#
+# *******************************************************************************************
+
+asciiToScan = [ 0 ] * 128
+
+def setASCII(c,code):
+	if c < 128 and asciiToScan[c] == 0:
+		asciiToScan[c] = code
+
+for s in rawData:
+	m = re.match("^([0-9\\sA-F]+)\\:\\:(.*?)\\:\\:(.*)$",s)
+	keycode = int(m.group(1).replace(" ",""),16)
+	if keycode >= 0x80:
+		keycode = (keycode & 0x7F) | 0x80
+	if len(m.group(2)) == 1:
+		setASCII(ord(m.group(2)),keycode)
+	if len(m.group(3).strip()) == 1:
+		setASCII(ord(m.group(3).strip()),keycode | 0x100)
+	m = re.search("\\[(\\d+)\\]",s)
+	if m is not None:
+		setASCII(int(m.group(1)),keycode)
+
 print("//\n//\t This file is automatically generated.\n//")
-print("static int sdlKeySymbolList[] = {{ {0} }};\n\n".format(table))
\ No newline at end of file
+if len(sys.argv) < 2 or sys.argv[1] != "ascii":
+	print("static int sdlKeySymbolList[] = {{ {0} }};\n\n".format(table))
+else:
+	print("static int asciiToScanCode[] = {{ {0} }};\n\n".format(",".join(["0x{0:x}".format(x) for x in asciiToScan])))
\ No newline at end of file
@@ -67,9 +67,43 @@ src = [x if x.find("//") < 0 else x[:x.find("//")] for x in src]
 src = [x.strip().replace("\t"," ").replace("\n"," ") for x in src if x.strip() != ""]
 
 #
-#		Output all lines beginning with ':' to the support file.
-#
-open("__6502support.h","w").write("\n".join([x[1:] for x in src if x[0] == ':']))
+#		Lines beginning with ':' are the support code. The core is a template over the bus, a class with static
+#		ReadByte(address) and WriteByte(address,data), so the including file can have several (e.g. F256, flat RAM)
+#		which the compiler inlines. Support functions which use the bus, or call one that does, are made templates
+#		on it, and calls to them, here and in the opcodes, are given <BUS>.
+#
+support = [x[1:] for x in src if x[0] == ':']
+functions = {}
+current = None
+for l in support:
+	m = re.match("^static\\s+\\w+\\s+(\\w+)\\(",l)
+	current = m.group(1) if m is not None else current
+	if current is not None:
+		functions[current] = functions.get(current,"") + l + "\n"
+busFunctions = set()
+busUse = re.compile("\\b(Read|Write|ReadWord|Fetch|FetchWord)\\(")
+changed = True
+while changed:
+	changed = False
+	for name,body in functions.items():
+		calls = [f for f in busFunctions if re.search("\\b"+f+"\\(",body.split("\n",1)[1]) is not None]
+		if name not in busFunctions and (busUse.search(body) is not None or len(calls) > 0):
+			busFunctions.add(name)
+			changed = True
+
+def busCalls(code):
+	for f in busFunctions:
+		code = re.sub("\\b"+f+"\\(",f+"<BUS>(",code)
+	return code
+
+for i in range(0,len(support)):
+	m = re.match("^static\\s+\\w+\\s+(\\w+)\\(",support[i])
+	if m is not None and m.group(1) in busFunctions:
+		support[i] = "template <class BUS> "+support[i].replace(m.group(1)+"(","@@")
+		support[i] = busCalls(support[i]).replace("@@",m.group(1)+"(")
+	else:
+		support[i] = busCalls(support[i])
+open("__6502support.h","w").write("\n".join(support))
 
 #
 #		Remove all those lines. Put | before lines beginning with "
@@ -142,6 +176,6 @@ handle = open("__6502opcodes.h","w")
 for i in range(0,256):
 	if codeList[i] is not None:
 		handle.write("case 0x{0:02x}: /* ${0:02x} {1} */\n".format(i,mnemonics[i]))
-		handle.write("\t{0};break;\n".format(codeList[i]).replace(";;",";"))
+		handle.write("\t{0};break;\n".format(busCalls(codeList[i])).replace(";;",";"))
 
 print("Successfully generated 65C02 opcodes.")
@@ -0,0 +1,2 @@
+static const BYTE8 __foenix_charset[] = { 0,0,0,0,0,0,0,0,126,129,165,129,189,153,129,126,60,126,219,255,195,126,60,0,0,238,254,254,124,56,16,0,16,56,124,254,124,56,16,0,0,60,24,255,255,8,24,0,16,56,124,254,254,16,56,0,0,0,24,60,24,0,0,0,255,255,231,195,231,255,255,255,0,60,66,129,129,66,60,0,255,195,189,126,126,189,195,255,1,3,7,15,31,63,127,255,255,254,252,248,240,224,192,128,4,6,7,4,4,252,248,0,12,10,13,11,249,249,31,31,0,146,124,68,198,124,146,0,0,0,96,120,126,120,96,0,0,0,6,30,126,30,6,0,24,126,24,24,24,24,126,24,102,102,102,102,102,0,102,0,255,182,118,54,54,54,54,0,126,193,220,34,34,31,131,126,0,0,0,126,126,0,0,0,24,126,24,24,126,24,0,255,24,126,24,24,24,24,24,0,24,24,24,24,24,126,24,0,0,4,6,255,6,4,0,0,0,32,96,255,96,32,0,0,0,0,0,192,192,192,255,0,0,36,102,255,102,36,0,0,0,0,16,56,124,254,0,0,0,0,0,254,124,56,16,0,0,0,0,0,0,0,0,0,48,48,48,48,48,0,48,0,102,102,0,0,0,0,0,0,108,108,254,108,254,108,108,0,16,124,210,124,134,124,16,0,240,150,252,24,62,114,222,0,48,72,48,120,206,204,120,0,12,12,24,0,0,0,0,0,16,96,192,192,192,96,16,0,16,12,6,6,6,12,16,0,0,84,56,254,56,84,0,0,0,24,24,126,24,24,0,0,0,0,0,0,0,0,24,112,0,0,0,126,0,0,0,0,0,0,0,0,0,0,24,0,2,6,12,24,48,96,192,0,124,206,222,246,230,230,124,0,24,56,120,24,24,24,60,0,124,198,6,12,48,96,254,0,124,198,6,60,6,198,124,0,14,30,54,102,254,6,6,0,254,192,192,252,6,6,252,0,124,198,192,252,198,198,124,0,254,6,12,24,48,96,96,0,124,198,198,124,198,198,124,0,124,198,198,126,6,198,124,0,0,48,0,0,0,48,0,0,0,48,0,0,0,48,32,0,0,28,48,96,48,28,0,0,0,0,126,0,126,0,0,0,0,112,24,12,24,112,0,0,124,198,12,24,48,0,48,0,124,130,154,170,170,158,124,0,124,198,198,254,198,198,198,0,252,102,102,124,102,102,252,0,124,198,192,192,192,198,124,0,252,102,102,102,102,102,252,0,254,98,104,120,104,98,254,0,254,98,104,120,104,96,240,0,124,198,198,192,222,198,124,0,198,198,198,254,198,198,198,0,60,24,24,24,24,24,60,0,30,12,12,12,12,204,120,0,198,204,216,240,216,204,198,0,240,96,96,96,96,98,254,0,198,238,254,214,198,198,198,0,198,230,246,222,206,198,198,0,124,198,198,198,198,198,124,0,252,102,102,124,96,96,240,0,124,198,198,198,198,198,124,12,252,102,102,124,102,102,230,0,124,198,192,124,6,198,124,0,126,90,24,24,24,24,60,0,198,198,198,198,198,198,124,0,198,198,198,198,198,108,56,0,198,198,198,198,214,238,198,0,198,108,56,56,56,108,198,0,102,102,102,60,24,24,60,0,254,198,12,24,48,102,254,0,28,24,24,24,24,24,28,0,192,96,48,24,12,6,2,0,112,48,48,48,48,48,112,0,0,0,16,56,108,198,0,0,0,0,0,0,0,0,0,255,48,48,24,0,0,0,0,0,0,0,124,6,126,198,126,0,192,192,252,198,198,198,252,0,0,0,124,198,192,198,124,0,6,6,126,198,198,198,126,0,0,0,124,198,254,192,124,0,60,102,96,240,96,96,96,0,0,0,126,198,198,126,6,124,192,192,252,198,198,198,198,0,24,0,56,24,24,24,60,0,0,12,0,28,12,12,204,120,192,192,198,216,240,216,198,0,56,24,24,24,24,24,60,0,0,0,238,254,214,198,198,0,0,0,252,198,198,198,198,0,0,0,124,198,198,198,124,0,0,0,252,198,198,252,192,192,0,0,126,198,198,126,6,6,0,0,222,118,96,96,96,0,0,0,124,192,124,6,124,0,24,24,126,24,24,24,30,0,0,0,198,198,198,198,126,0,0,0,198,198,198,108,56,0,0,0,198,198,214,254,198,0,0,0,198,108,56,108,198,0,0,0,198,198,198,126,6,124,0,0,254,12,24,96,254,0,14,24,24,112,24,24,14,0,24,24,24,0,24,24,24,0,224,48,48,28,48,48,224,0,0,0,112,154,14,0,0,0,0,0,24,60,102,255,0,0,124,198,192,192,198,124,24,112,102,0,198,198,198,198,126,0,14,24,124,198,254,192,124,0,24,36,124,6,126,198,126,0,102,0,124,6,126,198,126,0,56,12,124,6,126,198,126,0,24,0,124,6,126,198,126,0,0,0,124,192,192,124,24,112,24,36,124,198,254,192,124,0,102,0,124,198,254,192,124,0,112,24,124,198,254,192,124,0,102,0,56,24,24,24,60,0,24,36,56,24,24,24,60,0,56,12,56,24,24,24,60,0,102,0,124,198,254,198,198,0,24,0,124,198,254,198,198,0,14,24,254,96,120,96,254,0,0,0,124,26,126,216,126,0,126,216,216,222,248,216,222,0,24,36,124,198,198,198,124,0,102,0,124,198,198,198,124,0,56,12,124,198,198,198,124,0,24,36,198,198,198,198,126,0,56,12,198,198,198,198,126,0,102,0,198,198,198,126,6,124,102,124,198,198,198,198,124,0,198,0,198,198,198,198,124,0,24,124,198,192,198,124,24,0,30,50,48,120,48,112,254,0,102,60,24,126,24,60,24,0,252,198,252,192,204,222,204,14,0,28,50,48,252,48,240,0,14,24,124,6,126,198,126,0,26,48,56,24,24,24,60,0,14,24,124,198,198,198,124,0,14,24,198,198,198,198,126,0,102,152,252,198,198,198,198,0,102,152,230,246,222,206,198,0,124,6,126,198,126,0,254,0,124,198,198,198,124,0,254,0,24,0,24,48,96,198,124,0,0,0,254,192,192,192,192,0,0,0,254,6,6,6,6,0,192,192,192,222,6,12,30,0,192,192,192,204,28,62,12,0,48,0,48,48,48,48,48,0,0,54,108,216,108,54,0,0,0,216,108,54,108,216,0,0,170,170,170,170,170,170,170,170,170,85,170,85,170,85,170,85,68,34,68,34,68,34,68,34,24,24,24,24,24,24,24,24,24,24,24,248,24,24,24,24,24,24,24,248,24,248,24,24,54,54,54,246,54,54,54,54,0,0,0,254,54,54,54,54,0,0,0,248,24,248,24,24,54,54,54,246,6,246,54,54,54,54,54,54,54,54,54,54,0,0,0,254,6,246,54,54,54,54,54,246,6,254,0,0,54,54,54,254,0,0,0,0,24,24,24,248,24,248,0,0,0,0,0,248,24,24,24,24,24,24,24,31,0,0,0,0,24,24,24,255,0,0,0,0,0,0,0,255,24,24,24,24,24,24,24,31,24,24,24,24,0,0,0,255,0,0,0,0,24,24,24,255,24,24,24,24,24,24,24,31,24,31,24,24,54,54,54,55,54,54,54,54,54,54,54,55,48,63,0,0,0,0,0,63,48,55,54,54,54,54,54,247,0,255,0,0,0,0,0,255,0,247,54,54,54,54,54,55,48,55,54,54,0,0,0,255,0,255,0,0,54,54,54,247,0,247,54,54,24,24,24,255,0,255,0,0,54,54,54,255,0,0,0,0,0,0,0,255,0,255,24,24,0,0,0,255,54,54,54,54,54,54,54,63,0,0,0,0,24,24,24,31,24,31,0,0,0,0,0,31,24,31,24,24,0,0,0,63,54,54,54,54,54,54,54,255,54,54,54,54,24,24,24,255,24,255,24,24,24,24,24,248,0,0,0,0,0,0,0,31,24,24,24,24,255,255,255,255,255,255,255,255,0,0,0,0,255,255,255,255,240,240,240,240,240,240,240,240,15,15,15,15,15,15,15,15,255,255,255,255,0,0,0,0,0,0,119,152,152,119,0,0,28,54,102,252,198,198,252,192,254,98,96,96,96,96,96,0,0,0,255,102,102,102,102,0,254,98,48,24,48,98,254,0,0,0,63,102,198,204,120,0,0,0,51,51,51,62,48,240,0,0,255,24,24,24,24,0,60,24,60,102,102,60,24,60,0,124,198,254,198,124,0,0,0,126,195,195,195,102,231,0,30,25,60,102,198,204,120,0,0,0,102,153,153,102,0,0,0,3,124,206,230,124,192,0,0,62,192,254,192,62,0,0,0,126,195,195,195,195,0,0,0,254,0,254,0,254,0,0,24,24,126,24,24,126,0,0,112,24,12,24,112,0,254,0,28,48,96,48,28,0,254,0,0,14,27,24,24,24,24,24,24,24,24,24,24,216,112,0,0,24,0,126,0,24,0,0,0,118,220,0,118,220,0,0,60,102,60,0,0,0,0,0,0,24,60,24,0,0,0,0,0,0,0,0,24,0,0,0,15,12,12,12,236,108,56,0,216,236,204,204,0,0,0,0,240,48,192,240,0,0,0,0,0,0,0,60,60,60,60,0,0,0,0,0,0,0,0,0 } ;
+
@@ -11,45 +11,77 @@
 
 #include "sys_processor.h"
 #include "hardware.h"
+#include "sys_stats.h"
+#include "sys_disasm.h"
+#include "sys_runahead.h"
+#include "sys_latency.h"
+#include "sys_text.h"
+#include "sys_hash.h"
+#include "sys_capture.h"
+#include "sys_script.h"
+#include "hw_sn76489.h"
+#include "hw_hostcall.h"
 
 #include "gfx.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-#define QSIZE 	(10)
+#define QSIZE 	(256)									// Keyboard queue size (power of 2)
 
 struct _Queue {
+	int 	head;											// Ring buffer, head is next out
 	int   	count;
 	int   	queue[QSIZE];
 };
 
 struct _Queue keyboardQueue;
 
-static int SN76489_reg[8];										// 8 registers of 76489 (Tone/Attenuation 0..3)
-static int SN76489_current = 0;									// Currently selected register.
+static BYTE8 ioMemory[IO_MEMORY_SIZE];
+static int isSpeculating = 0; 									// Running ahead, so no sound.
+static int textWritten = 0; 									// Text page written this frame
 
-static BYTE8 ioMemory[4*0x4000];
+static LONG64 counterStart[HW_COUNTERS]; 						// Cycle count when started
+static BYTE8 counterRunning[HW_COUNTERS];
 
-static void HWWriteSoundChip(int data);
+static void HWWriteSoundChip(int chip,int data);
+static void HWLatchCounter(void);
+static void HWMathUpdate(void);
+static void HWWriteCounter(WORD16 address,BYTE8 data);
 static void IODMATransfer(BYTE8 *dmaReg,BYTE8 *ramMemory);
 
+// *******************************************************************************************************************************
+//
+//		Devices register handlers for blocks of IO_BLOCK_SIZE bytes in a page when the hardware is reset. A block
+//		without one is plain memory, so only accesses to a device's own registers pay for it. Write handlers store
+//		the byte themselves.
+//
+// *******************************************************************************************************************************
+
+#define IO_OFFSET(page,address) 	(((page) << 14)|((address) & 0x3FFF))
+
+static IOReadHandler readHandlers[IO_MEMORY_SIZE/IO_BLOCK_SIZE];
+static IOWriteHandler writeHandlers[IO_MEMORY_SIZE/IO_BLOCK_SIZE];
+
+void IORegisterDevice(BYTE8 page,WORD16 from,WORD16 to,IOReadHandler read,IOWriteHandler write) {
+	for (int block = IO_OFFSET(page,from)/IO_BLOCK_SIZE;block <= IO_OFFSET(page,to)/IO_BLOCK_SIZE;block++) {
+		if (read != NULL) readHandlers[block] = read; 					// NULL leaves it alone
+		if (write != NULL) writeHandlers[block] = write;
+	}
+}
+
 // *******************************************************************************************************************************
 //												Read from I/O Space
 // *******************************************************************************************************************************
 
 BYTE8 IOReadMemory(BYTE8 page,WORD16 address) {
-	if (page == 0) {
-		if (address >= 0xD640 && address < 0xD650) {
-			return HWReadKeyboardHardware(address);
-		}
-		if (address == 0xD6A5 || address == 0xD6A4) {
-			return rand() & 0xFF;
-		}
-		if (address == 0xDC00) {
-			return GFXReadJoystick0() ^ 0xFF;
-		}
-	}
-	return ioMemory[(page << 14)|(address & 0x3FFF)];
+	int offset = IO_OFFSET(page,address);
+	IOReadHandler handler = readHandlers[offset/IO_BLOCK_SIZE];
+	return (handler == NULL) ? ioMemory[offset] : (*handler)(page,address);
+}
+
+BYTE8 *IOAccessMemory(void) { 														// All four pages, page << 14
+	return ioMemory;
 }
 
 // *******************************************************************************************************************************
@@ -57,33 +89,126 @@ BYTE8 IOReadMemory(BYTE8 page,WORD16 address) {
 // *******************************************************************************************************************************
 
 void IOWriteMemory(BYTE8 page,WORD16 address,BYTE8 data) {
-	if (page == 0) {
-		if (address == 0xD600 || address == 0xD610) {
-			HWWriteSoundChip(data);
-		}
-		if (address >= 0xD640 && address < 0xD650) {
-			HWWriteKeyboardHardware(address,data);
-		}
+	int offset = IO_OFFSET(page,address);
+	IOWriteHandler handler = writeHandlers[offset/IO_BLOCK_SIZE];
+	if (handler == NULL) {
+		ioMemory[offset] = data;
+	} else {
+		(*handler)(page,address,data);
+	}
+}
+
+// *******************************************************************************************************************************
+//												Device read handlers
+// *******************************************************************************************************************************
+
+static BYTE8 HWReadKeyboard(BYTE8 page,WORD16 address) { 							// $D640-$D64F
+	return HWReadKeyboardHardware(address);
+}
+
+static BYTE8 HWReadRandom(BYTE8 page,WORD16 address) { 								// $D6A4-$D6A5
+	if (address == 0xD6A5 || address == 0xD6A4) return rand() & 0xFF;
+	return ioMemory[IO_OFFSET(page,address)];
+}
+
+static BYTE8 HWReadJoystick(BYTE8 page,WORD16 address) { 							// $DC00
+	if (address == 0xDC00) return GFXReadJoystick0() ^ 0xFF;
+	return ioMemory[IO_OFFSET(page,address)];
+}
+
+static BYTE8 HWReadCounter(BYTE8 page,WORD16 address) { 							// $DEA0 latches
+	if (address == HW_COUNTER) HWLatchCounter();
+	return ioMemory[IO_OFFSET(page,address)];
+}
+
+// *******************************************************************************************************************************
+//												Device write handlers
+// *******************************************************************************************************************************
+
+static void HWWriteFont(BYTE8 page,WORD16 address,BYTE8 data) { 					// Font and LUTs
+	HSHPaletteWritten();
+	ioMemory[IO_OFFSET(page,address)] = data;
+}
+
+static void HWWriteText(BYTE8 page,WORD16 address,BYTE8 data) { 					// Text and colour
+	TXTWritten(address);
+	if (page == 2) textWritten = -1;
+	ioMemory[IO_OFFSET(page,address)] = data;
+}
+
+static void HWWriteSound(BYTE8 page,WORD16 address,BYTE8 data) { 					// $D600 and $D610
+	if (address == 0xD600 || address == 0xD610) {
+		HWWriteSoundChip(address == 0xD610,data);
+	}
+	ioMemory[IO_OFFSET(page,address)] = data;
+}
+
+static void HWWriteKeyboard(BYTE8 page,WORD16 address,BYTE8 data) {
+	HWWriteKeyboardHardware(address,data);
+	ioMemory[IO_OFFSET(page,address)] = data;
+}
+
+static void HWWriteMath(BYTE8 page,WORD16 address,BYTE8 data) { 					// Results ready at once
+	ioMemory[IO_OFFSET(page,address)] = data;
+	HWMathUpdate();
+}
+
+static void HWWriteHostCall(BYTE8 page,WORD16 address,BYTE8 data) {
+	ioMemory[IO_OFFSET(page,address)] = data;
+	if (address == HCL_COMMAND && isSpeculating == 0) {
+		HCLCommand(ioMemory+(HCL_BASE & 0x3FFF),CPUAccessMemory());
+	}
+}
+
+static void HWWriteCounterRegister(BYTE8 page,WORD16 address,BYTE8 data) {
+	ioMemory[IO_OFFSET(page,address)] = data;
+	if (address >= HW_COUNTER_START && address <= HW_COUNTER_CLEAR) {
+		HWWriteCounter(address,data);
 	}
-	ioMemory[(page << 14)|(address & 0x3FFF)] = data;
-	if (page == 0 && address == 0xDF00 && (data & 0x80) != 0) {
+}
+
+static void HWWriteDMA(BYTE8 page,WORD16 address,BYTE8 data) {
+	ioMemory[IO_OFFSET(page,address)] = data;
+	if (address == 0xDF00 && (data & 0x80) != 0) {
 		IODMATransfer(ioMemory+(0xDF00 & 0x3FFF),CPUAccessMemory());
 		IOWriteMemory(0,0xDF01,0);
 	}
 }
 
+// *******************************************************************************************************************************
+//												Register the devices
+// *******************************************************************************************************************************
+
+static void HWRegisterDevices(void) {
+	memset(readHandlers,0,sizeof(readHandlers));
+	memset(writeHandlers,0,sizeof(writeHandlers));
+	IORegisterDevice(1,0xC000,0xFFFF,NULL,HWWriteFont);
+	IORegisterDevice(2,0xC000,0xFFFF,NULL,HWWriteText);
+	IORegisterDevice(3,0xC000,0xFFFF,NULL,HWWriteText);
+	IORegisterDevice(0,0xD600,0xD61F,NULL,HWWriteSound);
+	IORegisterDevice(0,0xD640,0xD64F,HWReadKeyboard,HWWriteKeyboard);
+	IORegisterDevice(0,0xD6A4,0xD6A5,HWReadRandom,NULL);
+	IORegisterDevice(0,0xDC00,0xDC00,HWReadJoystick,NULL);
+	IORegisterDevice(0,HW_MATH,HW_MATH_END,NULL,HWWriteMath);
+	IORegisterDevice(0,HCL_COMMAND,HCL_COMMAND,NULL,HWWriteHostCall);
+	IORegisterDevice(0,HW_COUNTER,HW_COUNTER_CLEAR,HWReadCounter,HWWriteCounterRegister);
+	IORegisterDevice(0,0xDF00,0xDF00,NULL,HWWriteDMA);
+}
+
 // *******************************************************************************************************************************
 //												Insert/Delete Queue
 // *******************************************************************************************************************************
 
-static void HWQueueInsert(struct _Queue *q,int value) {
-	if (q->count < QSIZE) q->queue[q->count++] = value;
+static int HWQueueInsert(struct _Queue *q,int value) {
+	if (q->count == QSIZE) return 0; 						// Full, lost.
+	q->queue[(q->head + q->count++) & (QSIZE-1)] = value;
+	return -1;
 }
 
 static int HWQueueRemove(struct _Queue *q) {
 	if (q->count == 0) return -1;
-	int r = q->queue[0];
-	for (int i = 0;i < q->count;i++) q->queue[i] = q->queue[i+1];
+	int r = q->queue[q->head];
+	q->head = (q->head + 1) & (QSIZE-1);
 	q->count--;
 	return r;
 }
@@ -95,12 +220,19 @@ static int HWQueueRemove(struct _Queue *q) {
 #include "roms/__foenix_charset.h"
 
 void HWReset(void) {
-	keyboardQueue.count = 0;
+	keyboardQueue.head = keyboardQueue.count = 0;
+	LATReset();
+	HWTypeReset();
 	HWResetKeyboardHardware();
+	HWRegisterDevices();
+	for (int i = 0;i < HW_COUNTERS;i++) {
+		HWWriteCounter(HW_COUNTER_CLEAR,i);
+	}
+	for (int i = HW_MATH;i < HW_MATH_RESULTS;i++) IOWriteMemory(0,i,0);
+	SNReset();
 	for (int i = 0;i < 4;i++) {				
-		SN76489_reg[i*2+1] = 0xF;							// Set all attenuation to $F e.g. off
-		SN76489_reg[i*2+0] = 0;								// Pitch zero.
-		GFXSetFrequency(i,0);								// All beepers off
+		HWWriteSoundChip(0,0x9F | (i << 5));				// Set all attenuation to $F e.g. off
+		HWWriteSoundChip(1,0x9F | (i << 5));
 	}
 	for (int i = 0;i < 0x800;i++) {
 		IOWriteMemory(1,0xC000+i,__foenix_charset[i]);
@@ -110,19 +242,49 @@ void HWReset(void) {
 }
 
 // *******************************************************************************************************************************
-//												  Reset CPU
+//
+//		Keyboard, called several times a frame. Text being typed is converted into the queue while there is room, and
+//		a byte moves into the FIFO as soon as the guest has emptied it. At the end of a frame the interrupt is raised
+//		again if the FIFO still has data, as it is lost if the CPU has interrupts disabled.
+//
 // *******************************************************************************************************************************
 
-void HWSync(void) {
-	if (keyboardQueue.count != 0) {
+void HWKeyboardSync(int isEndFrame) {
+	int bytes[HW_TYPE_MAX_BYTES];
+	while (isSpeculating == 0 && QSIZE - keyboardQueue.count >= HW_TYPE_MAX_BYTES) { // Type any text
+		int n = HWTypeNext(bytes);
+		if (n == 0) break;
+		for (int i = 0;i < n;i++) HWQueueKeyboardEvent(bytes[i]);
+	}
+	int raise = isEndFrame && !HWKeyboardHardwareEmpty();
+	if (keyboardQueue.count != 0 && HWKeyboardHardwareEmpty()) {
 		int key = HWQueueRemove(&keyboardQueue);
 		HWKeyboardHardwareDequeue(key);
 		//printf("Dequeue %x\n",key);
-		if (HWCheckKeyboardInterruptEnabled()) {
-			//printf("Interrupt\n");
-			CPUInterruptMaskable();							// fire IRQ
-		}
+		raise = -1;
+	}
+	if (raise && HWCheckKeyboardInterruptEnabled()) {
+		//printf("Interrupt\n");
+		LATInterrupt();
+		CPUInterruptMaskable();								// fire IRQ
+	}
+}
+
+// *******************************************************************************************************************************
+//												  End of frame
+// *******************************************************************************************************************************
+
+void HWSync(void) {
+	LATTestFrame(); 										// Typing keys for the latency test
+	if (isSpeculating == 0) {
+		HSHEndFrame(); 										// Frame hashes, if wanted
+		CAPEndFrame(); 										// Capture, if wanted
+		SNSync(); 											// Sound can play up to here
+		SCRFrame(); 										// Script, if there is one
+		if (keyboardQueue.count == 0) HWTypeFrame(textWritten); // Line pause once it has all gone
+		textWritten = 0;
 	}
+	HWKeyboardSync(-1);
 	if (IOReadMemory(0,0xD658) & 1) { 						// Timer on.
 		int a = 0xD659;
 		int c = 1;
@@ -147,41 +309,111 @@ void HWWriteDisplay(WORD16 address,BYTE8 data) {
 // *******************************************************************************************************************************
 
 void HWQueueKeyboardEvent(int ps2code) {
-	HWQueueInsert(&keyboardQueue,ps2code);
+	static int lastCode = 0;
+	if (ps2code != 0xE0 && ps2code != 0xF0 && lastCode != 0xF0) {
+		RAHKeyEvent(); 										// Key pressed, time it if measuring latency
+	}
+	lastCode = ps2code;
+	LATQueued(ps2code,HWQueueInsert(&keyboardQueue,ps2code)); // Measuring, if full it is lost
 }
 
 // *******************************************************************************************************************************
-//								Write byte to 76489, handles left & right
+//						Write byte to 76489, chip 0 is left ($D600), 1 is right ($D610)
 // *******************************************************************************************************************************
 
+static void HWWriteSoundChip(int chip,int data) {
+	if (isSpeculating) return; 										// Will be written again for real
+	SNWrite(chip,data);
+	CAPSoundWrite(chip,data); 										// Recording, if wav@<file>
+}
 
-static int _HWGetFrequency(void) {
-	int rPair = SN76489_current & 0xFE;
-	if (SN76489_reg[rPair+1] != 0 || SN76489_reg[rPair] == 0) return 0;
-	return 111563 / SN76489_reg[rPair];
+// *******************************************************************************************************************************
+//
+//		Math coprocessor, worked out whenever an operand is written. $DE00 x $DE02 (16 bit) is at $DE10 (32 bit),
+//		$DE06 / $DE04 (16 bit) gives the quotient at $DE14 and the remainder at $DE16, $DE08 + $DE0C (32 bit) is at
+//		$DE18. Dividing by zero gives a quotient of $FFFF and leaves the numerator as the remainder.
+//
+// *******************************************************************************************************************************
+
+static LONG32 HWMathRead(WORD16 address,int bytes) {
+	BYTE8 *p = ioMemory + (address & 0x3FFF);
+	LONG32 n = 0;
+	for (int i = bytes-1;i >= 0;i--) n = (n << 8) | p[i];
+	return n;
+}
+
+static void HWMathWrite(WORD16 address,int bytes,LONG32 n) {
+	BYTE8 *p = ioMemory + (address & 0x3FFF);
+	for (int i = 0;i < bytes;i++) p[i] = (n >> (i * 8)) & 0xFF;
+}
+
+static void HWMathUpdate(void) {
+	HWMathWrite(0xDE10,4,HWMathRead(0xDE00,2) * HWMathRead(0xDE02,2));
+	LONG32 denominator = HWMathRead(0xDE04,2),numerator = HWMathRead(0xDE06,2);
+	HWMathWrite(0xDE14,2,(denominator == 0) ? 0xFFFF : numerator / denominator);
+	HWMathWrite(0xDE16,2,(denominator == 0) ? numerator : numerator % denominator);
+	HWMathWrite(0xDE18,4,HWMathRead(0xDE08,4) + HWMathRead(0xDE0C,4));
+}
+
+// *******************************************************************************************************************************
+//
+//		Cycle counter, 48 bits at $DEA0-$DEA5, copied there when $DEA0 is read. The accumulators at $DEB0-$DEBF add
+//		up the cycles between writing their number to $DEA8 (start) and $DEA9 (stop), so code can time itself.
+//
+// *******************************************************************************************************************************
+
+static void HWLatchCounter(void) {
+	LONG64 cycles = CPUGetCycleCount();
+	for (int i = 0;i < 6;i++) ioMemory[(HW_COUNTER & 0x3FFF)+i] = (cycles >> (i * 8)) & 0xFF;
 }
 
-static void HWWriteSoundChip(int data) {
-	int startFreq,endFreq;
-	if (data & 0x80) {
-		SN76489_current = (data >> 4) & 7;
+static void HWWriteCounter(WORD16 address,BYTE8 data) {
+	int n = data & (HW_COUNTERS-1);
+	BYTE8 *accumulator = ioMemory + (HW_ACCUMULATORS & 0x3FFF) + n * 4;
+	LONG32 total = accumulator[0] | (accumulator[1] << 8) | (accumulator[2] << 16) | (accumulator[3] << 24);
+	LONG64 now = CPUGetCycleCount();
+	if (address == HW_COUNTER_START) {
+		counterStart[n] = now;counterRunning[n] = -1;
 	}
-	startFreq = _HWGetFrequency();
-	if (data & 0x80) {
-		SN76489_reg[SN76489_current] &= 0xFFF0;
-		SN76489_reg[SN76489_current] |= data & 0x0F;
-	} else {
-		SN76489_reg[SN76489_current] &= 0x000F;
-		SN76489_reg[SN76489_current] |= ((data & 0x3F) << 4);
+	if (address == HW_COUNTER_STOP && counterRunning[n]) {
+		total += (LONG32)(now - counterStart[n]);counterRunning[n] = 0;
 	}
-	//printf("Register %d is %x %d\n",SN76489_current,SN76489_reg[SN76489_current],SN76489_reg[SN76489_current]);
-	endFreq = _HWGetFrequency();
-	if (startFreq != endFreq) {
-		int gChannel = (SN76489_current >> 1) ^ 3;
-		//printf("Changing pitch of %d to %d\n",gChannel,endFreq);
-		GFXSetFrequency(endFreq,gChannel);
+	if (address == HW_COUNTER_CLEAR) {
+		total = 0;counterRunning[n] = 0;
 	}
-	//printf("Change: %d %d\n",endFreq,startFreq);
+	for (int i = 0;i < 4;i++) accumulator[i] = (total >> (i * 8)) & 0xFF;
+}
+
+// *******************************************************************************************************************************
+//				Save and restore hardware state for run-ahead, sound chip writes are ignored in between
+// *******************************************************************************************************************************
+
+static struct _HWState {
+	struct _Queue keyboardQueue;
+	BYTE8 ioMemory[IO_MEMORY_SIZE];
+	LONG64 counterStart[HW_COUNTERS];
+	BYTE8 counterRunning[HW_COUNTERS];
+} saved;
+
+void HWSaveState(void) {
+	saved.keyboardQueue = keyboardQueue;
+	memcpy(saved.ioMemory,ioMemory,sizeof(ioMemory));
+	memcpy(saved.counterStart,counterStart,sizeof(counterStart));
+	memcpy(saved.counterRunning,counterRunning,sizeof(counterRunning));
+	HWSaveKeyboardHardware();
+	isSpeculating = -1;
+	LATSpeculating(-1);
+}
+
+void HWRestoreState(void) {
+	keyboardQueue = saved.keyboardQueue;
+	memcpy(ioMemory,saved.ioMemory,sizeof(ioMemory));
+	memcpy(counterStart,saved.counterStart,sizeof(counterStart));
+	memcpy(counterRunning,saved.counterRunning,sizeof(counterRunning));
+	HWRestoreKeyboardHardware();
+	HSHInvalidate(); 												// I/O pages copied back
+	isSpeculating = 0;
+	LATSpeculating(0);
 }
 
 // *******************************************************************************************************************************
@@ -189,6 +421,7 @@ static void HWWriteSoundChip(int data) {
 // *******************************************************************************************************************************
 
 static void IODMATransfer(BYTE8 *dmaReg,BYTE8 *ramMemory) {
+	DISInvalidateAll(); 															// Code may have been moved.
 	int src = (dmaReg[4]+(dmaReg[5] << 8)+(dmaReg[6] << 16)) & 0x3FFFF;
 	int tgt = (dmaReg[8]+(dmaReg[9] << 8)+(dmaReg[10] << 16)) & 0x3FFFF;
 	int fillByte = dmaReg[1];
@@ -196,6 +429,7 @@ static void IODMATransfer(BYTE8 *dmaReg,BYTE8 *ramMemory) {
 
 	if ((dmaReg[0] & 0x02) == 0) {				/* 1D operation */
 		int count = (dmaReg[12]+(dmaReg[13] << 8)+(dmaReg[14] << 16)) & 0x3FFFF;
+		STSAdd(STS_DMA_BYTES,count);
 		while (count-- > 0) {
 			ramMemory[tgt & 0x3FFFF] = isFill ? fillByte : ramMemory[src & 0x3FFFF];
 			tgt++;src++;
@@ -205,6 +439,7 @@ static void IODMATransfer(BYTE8 *dmaReg,BYTE8 *ramMemory) {
 		int height = dmaReg[14]+(dmaReg[15] << 8);
 		int strideSrc = dmaReg[16]+(dmaReg[17] << 8);
 		int strideTgt = dmaReg[18]+(dmaReg[19] << 8);
+		STSAdd(STS_DMA_BYTES,width*height);
 		for (int w = 0;w < width;w++) {
 			for (int h = 0;h < height;h++) {
 				ramMemory[(tgt+w+h*strideTgt) & 0x3FFFF] = isFill ? fillByte : ramMemory[(src+w+h*strideSrc) & 0x3FFFF];
@@ -11,15 +11,17 @@
 
 #include "sys_processor.h"
 #include "hardware.h"
+#include "sys_latency.h"
 
 #include "gfx.h"
 #include <stdio.h>
 #include <stdlib.h>
 
-#define FIFO_QUEUE_SIZE		(8)
+#define FIFO_QUEUE_SIZE		(8) 								// Power of 2, it is a ring buffer
 
-static int queueSize;
+static int queueSize,queueHead; 						// Bytes in FIFO, next one out
 static int fifoQueue[FIFO_QUEUE_SIZE];
+static int savedSize,savedHead,savedQueue[FIFO_QUEUE_SIZE]; // Copy for run-ahead
 
 // *******************************************************************************************************************************
 //
@@ -28,7 +30,11 @@ static int fifoQueue[FIFO_QUEUE_SIZE];
 // *******************************************************************************************************************************
 
 void HWResetKeyboardHardware(void) {	
-	queueSize = 0;
+	queueSize = queueHead = 0;
+}
+
+int HWKeyboardHardwareEmpty(void) {
+	return queueSize == 0;
 }
 
 // *******************************************************************************************************************************
@@ -39,8 +45,9 @@ void HWResetKeyboardHardware(void) {
 
 void HWKeyboardHardwareDequeue(int key) {
 	//printf("Received : %x\n",key);
+	LATFifo(queueSize < FIFO_QUEUE_SIZE);
 	if (queueSize < FIFO_QUEUE_SIZE) {
-		fifoQueue[queueSize++] = key;
+		fifoQueue[(queueHead + queueSize++) & (FIFO_QUEUE_SIZE-1)] = key;
 	}
 }
 
@@ -55,11 +62,10 @@ BYTE8 HWReadKeyboardHardware(WORD16 address) {
 		return (queueSize == 0) ? 1 : 0;
 	}
 	if (address == 0xD642 && queueSize > 0) {
-		int head = fifoQueue[0];
+		int head = fifoQueue[queueHead];
+		LATRead();
 		//printf("Popped : %x\n",head);
-		for (int i = 0;i < queueSize;i++) {
-			fifoQueue[i] = fifoQueue[i+1];
-		}
+		queueHead = (queueHead + 1) & (FIFO_QUEUE_SIZE-1);
 		queueSize--;
 		return head;
 	}
@@ -88,4 +94,19 @@ int HWCheckKeyboardInterruptEnabled(void) {
 		return -1;
 	}
 	return 0;
-}
\ No newline at end of file
+}
+// *******************************************************************************************************************************
+//
+//											Save and restore for run-ahead
+//
+// *******************************************************************************************************************************
+
+void HWSaveKeyboardHardware(void) {
+	savedSize = queueSize;savedHead = queueHead;
+	for (int i = 0;i < FIFO_QUEUE_SIZE;i++) savedQueue[i] = fifoQueue[i];
+}
+
+void HWRestoreKeyboardHardware(void) {
+	queueSize = savedSize;queueHead = savedHead;
+	for (int i = 0;i < FIFO_QUEUE_SIZE;i++) fifoQueue[i] = savedQueue[i];
+}
@@ -0,0 +1,120 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		hw_hostcall.cpp
+//		Purpose:	Host call registers at $DE80-$DE9F in I/O page 0, enabled with 'hostcall'. Writing the command
+//					register prints to stdout, loads or saves a host file in physical memory, reads a microsecond
+//					timer or exits the emulator. The parameters are registers too, little endian. Otherwise (and while
+//					running ahead) they are ordinary I/O memory, so a guest can set the status to $FF and see if it
+//					changes.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sys_processor.h"
+#include "sys_disasm.h"
+#include "hw_hostcall.h"
+#include "gfx.h"
+
+static int isEnabled = 0;
+static int exitCode = -1; 															// Set when the guest asks to exit
+static LONG64 startTime;
+
+#define REG(a) 		registers[(a)-HCL_BASE]
+#define REG24(a) 	(REG(a) | (REG((a)+1) << 8) | (REG((a)+2) << 16))
+
+void HCLEnable(void) {
+	if (isEnabled) return;
+	isEnabled = -1;
+	startTime = SDL_GetPerformanceCounter();
+}
+
+// *******************************************************************************************************************************
+//								A file name from memory, only relative names in or below here
+// *******************************************************************************************************************************
+
+static int _HCLName(BYTE8 *registers,BYTE8 *memory,char *name) {
+	int address = REG24(HCL_NAME);
+	int n = 0;
+	while (address < MEMSIZE && memory[address] != 0 && n < HCL_MAX_NAME-1) name[n++] = memory[address++];
+	name[n] = '\0';
+	if (n == 0 || address >= MEMSIZE || memory[address] != 0) return 0;
+	if (name[0] == '/' || name[0] == '\\' || strchr(name,':') != NULL || strstr(name,"..") != NULL) return 0;
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//											Do the command just written
+// *******************************************************************************************************************************
+
+void HCLCommand(BYTE8 *registers,BYTE8 *memory) {
+	if (isEnabled == 0 || exitCode >= 0) return;
+	int address = REG24(HCL_ADDRESS);
+	int length = REG24(HCL_LENGTH);
+	int status = HCL_OK;
+	char name[HCL_MAX_NAME];
+	FILE *f;
+
+	switch(REG(HCL_COMMAND)) {
+		case HCL_PRINT:
+			while (address < MEMSIZE && memory[address] != 0) fputc(memory[address++],stdout);
+			fflush(stdout);
+			break;
+
+		case HCL_WRITE:
+			if (address + length > MEMSIZE) { status = HCL_BAD_ADDRESS;break; }
+			fwrite(memory+address,1,length,stdout);
+			fflush(stdout);
+			break;
+
+		case HCL_LOAD:
+			if (address >= MEMSIZE) { status = HCL_BAD_ADDRESS;break; }
+			if (!_HCLName(registers,memory,name)) { status = HCL_BAD_NAME;break; }
+			f = fopen(name,"rb");
+			if (f == NULL) { status = HCL_FILE_ERROR;break; }
+			if (length == 0 || address + length > MEMSIZE) length = MEMSIZE - address;
+			length = fread(memory+address,1,length,f);
+			fclose(f);
+			REG(HCL_LENGTH) = length & 0xFF;REG(HCL_LENGTH+1) = (length >> 8) & 0xFF;REG(HCL_LENGTH+2) = length >> 16;
+			DISInvalidateAll(); 													// Written without going through _Write
+			break;
+
+		case HCL_SAVE:
+			if (address + length > MEMSIZE) { status = HCL_BAD_ADDRESS;break; }
+			if (!_HCLName(registers,memory,name)) { status = HCL_BAD_NAME;break; }
+			f = fopen(name,"wb");
+			if (f == NULL) { status = HCL_FILE_ERROR;break; }
+			if ((int)fwrite(memory+address,1,length,f) != length) status = HCL_FILE_ERROR;
+			fclose(f);
+			break;
+
+		case HCL_READ_TIMER: {
+			LONG64 us = (SDL_GetPerformanceCounter() - startTime) * 1000000ULL / SDL_GetPerformanceFrequency();
+			for (int i = 0;i < 8;i++) REG(HCL_TIMER+i) = (us >> (i * 8)) & 0xFF;
+			break;
+		}
+
+		case HCL_EXIT:
+			exitCode = length & 0xFF;
+			CPUExit();
+			break;
+
+		default:
+			status = HCL_BAD_COMMAND;
+			break;
+	}
+	REG(HCL_STATUS) = status;
+}
+
+// *******************************************************************************************************************************
+//										Exit with the guest's code, if it asked
+// *******************************************************************************************************************************
+
+void HCLEndRun(void) {
+	if (exitCode >= 0) exit(exitCode);
+}
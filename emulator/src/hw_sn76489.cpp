@@ -0,0 +1,472 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		hw_sn76489.cpp
+//		Purpose:	SN76489 sound chips, $D600 on the left and $D610 on the right. Tones and the noise clock are
+//					fixed point phase accumulators, the noise is the chip's 15 bit shift register, and each change of
+//					level is added as a band limited step, so high notes don't alias. The CPU queues register writes,
+//					stamped with the cycle count, without locking, and the audio callback plays them at that time.
+//					With audiosync the CPU makes the samples instead, and the sound card's buffer paces it.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "hw_sn76489.h"
+
+#define CYCLES_PER_SAMPLE 	(((LONG64)SN_CYCLE_RATE << 16) / SN_SAMPLE_RATE) 		// 16.16 fixed point
+
+static short kernel[SN_KERNEL_PHASES][SN_KERNEL_WIDTH]; 							// Band limited impulses, each sums to 32768
+static int volumeTable[16]; 														// 2dB a step, 15 is off
+static int isInitialised = 0;
+
+struct _SNWrite {
+	LONG32 	cycle; 																	// CPU cycle count, low 32 bits
+	BYTE8 	chip,data;
+};
+
+static struct _SNEngine playback; 													// Played by the audio callback
+static struct _SNWrite queue[SN_QUEUE_SIZE];
+static SDL_atomic_t queueHead,queueTail; 											// Written by CPU / audio callback only
+static SDL_atomic_t publishedCycle; 												// CPU cycle count at the last frame end
+static SDL_atomic_t silenceRequest;
+static LONG64 audioTime; 															// Cycle count being played, 16.16
+
+#define SN_DEVICE_NONE 		(0) 													// No callback yet, write the engine directly
+#define SN_DEVICE_QUEUED 	(1) 													// Callback plays the queue of writes
+#define SN_DEVICE_SYNC 		(2) 													// Callback plays the ring, CPU owns the engine
+
+static int deviceMode = SN_DEVICE_NONE;
+static int wantAudioSync = 0,bufferSize = SN_DEFAULT_BUFFER;
+static short ring[SN_RING_SIZE*2]; 													// audiosync stereo samples
+static SDL_atomic_t ringHead,ringTail; 												// Written by CPU / audio callback only
+static SDL_atomic_t underruns,isStopped,hasStarted;
+static int overruns = 0,isMuted = 0,targetFill;
+static LONG64 producedTime; 														// Cycle count made up to, 16.16
+static int hasProduced = 0; 														// producedTime has been set
+static int resamplePos = 0x10000,resampleStep = 0x10000; 							// Input sample position, 16.16
+static int resampleLast[2];
+static double averageFill = 0.0;
+static int minimumStep = 0x10000,maximumStep = 0x10000;
+static int stalledTail = -1; 														// Ring position when the card stopped taking
+
+// *******************************************************************************************************************************
+//
+//		Kernel and volumes. Each kernel row is a windowed sinc, cut off a little below half the sample rate, for a step
+//		that falls that fraction of the way through a sample. Adding up the impulses gives the band limited step.
+//
+// *******************************************************************************************************************************
+
+static void _SNInitialise(void) {
+	isInitialised = 1;
+	for (int p = 0;p < SN_KERNEL_PHASES;p++) {
+		double h[SN_KERNEL_WIDTH],sum = 0.0;
+		for (int k = 0;k < SN_KERNEL_WIDTH;k++) {
+			double x = k - (SN_KERNEL_WIDTH/2 - 1) - (double)p / SN_KERNEL_PHASES;
+			double t = x / (SN_KERNEL_WIDTH/2);
+			double sinc = (x == 0.0) ? 1.0 : sin(M_PI*0.9*x) / (M_PI*0.9*x);
+			double window = (fabs(t) > 1.0) ? 0.0 : 0.42 + 0.5*cos(M_PI*t) + 0.08*cos(2*M_PI*t);
+			h[k] = sinc * window;sum += h[k];
+		}
+		int total = 0;
+		for (int k = 0;k < SN_KERNEL_WIDTH;k++) {
+			kernel[p][k] = (short)floor(h[k] / sum * 32768.0 + 0.5);
+			total += kernel[p][k];
+		}
+		kernel[p][SN_KERNEL_WIDTH/2-1] += 32768 - total; 							// Exactly, so levels don't drift
+	}
+	for (int i = 0;i < 15;i++) volumeTable[i] = (int)(SN_VOLUME * pow(10.0,-2.0*i/20.0));
+	volumeTable[15] = 0;
+}
+
+// *******************************************************************************************************************************
+//												Reset an engine to silence
+// *******************************************************************************************************************************
+
+static void _SNSteps(struct _SNChip *c) {
+	for (int ch = 0;ch < 4;ch++) { 													// Toggles a second / sample rate
+		int n = (ch < 3) ? c->tone[ch] : (0x10 << (c->noise & 3));
+		if (n == 0) n = 0x400;
+		c->step[ch] = ((LONG64)SN_CLOCK << 32) / (16LL * n * SN_SAMPLE_RATE);
+	}
+	if ((c->noise & 3) == 3) c->step[3] = 0; 										// Clocked by tone 2 instead
+}
+
+void SNEngineReset(struct _SNEngine *e) {
+	if (isInitialised == 0) _SNInitialise();
+	memset(e,0,sizeof(struct _SNEngine));
+	for (int i = 0;i < 2;i++) {
+		for (int ch = 0;ch < 4;ch++) e->chip[i].attenuation[ch] = 15;
+		e->chip[i].lfsr = 0x4000;
+		_SNSteps(&e->chip[i]);
+	}
+}
+
+// *******************************************************************************************************************************
+//						Add a change of level, at sample index plus phase/SN_KERNEL_PHASES
+// *******************************************************************************************************************************
+
+static inline void _SNDelta(int *buffer,int index,int phase,int delta) {
+	const short *k = kernel[phase];
+	buffer += index;
+	for (int i = 0;i < SN_KERNEL_WIDTH;i++) buffer[i] += delta * k[i];
+}
+
+static void _SNSetLevel(struct _SNChip *c,int *buffer,int ch,int index,int phase) {
+	int vol = volumeTable[c->attenuation[ch]];
+	int on = (ch < 3) ? c->output[ch] : c->noiseOut;
+	int level = on ? vol : -vol;
+	if (level != c->level[ch]) {
+		_SNDelta(buffer,index,phase,level - c->level[ch]);
+		c->level[ch] = level;
+	}
+}
+
+// *******************************************************************************************************************************
+//				Write a register. Takes effect at the start of the next sample made by SNEngineRender()
+// *******************************************************************************************************************************
+
+void SNEngineWrite(struct _SNEngine *e,int chip,int data) {
+	struct _SNChip *c = &e->chip[chip & 1];
+	if (data & 0x80) c->latch = (data >> 4) & 7; 									// Latch byte selects register
+	int ch = c->latch >> 1;
+	if (c->latch & 1) { 															// Attenuation
+		c->attenuation[ch] = data & 0x0F;
+	} else if (ch == 3) { 															// Noise control, resets the register
+		c->noise = data & 7;
+		c->lfsr = 0x4000;
+	} else if (data & 0x80) { 														// Tone, low 4 bits
+		c->tone[ch] = (c->tone[ch] & 0x3F0) | (data & 0x0F);
+	} else { 																		// Tone, high 6 bits
+		c->tone[ch] = (c->tone[ch] & 0x00F) | ((data & 0x3F) << 4);
+	}
+	_SNSteps(c);
+	_SNSetLevel(c,e->buffer[chip & 1],ch,0,0);
+}
+
+// *******************************************************************************************************************************
+//
+//		Make n samples for one chip. A channel's phase overflowing is a toggle ; where in the sample it happened is
+//		(overflow point - phase) / step. The noise register shifts on every other toggle of its clock.
+//
+// *******************************************************************************************************************************
+
+static inline void _SNNoiseClock(struct _SNChip *c,int *buffer,int index,int phase) {
+	c->output[3] ^= 1;
+	if (c->output[3] == 0) return;
+	int feedback = (c->noise & 4) ? ((c->lfsr ^ (c->lfsr >> 1)) & 1) : (c->lfsr & 1); // White taps bits 0,1 ; periodic 0
+	c->lfsr = (c->lfsr >> 1) | (feedback << 14);
+	c->noiseOut = c->lfsr & 1;
+	_SNSetLevel(c,buffer,3,index,phase);
+}
+
+static void _SNRenderChip(struct _SNChip *c,int *buffer,int n) {
+	for (int ch = 0;ch < 4;ch++) {
+		LONG64 step = c->step[ch],phase = c->phase[ch];
+		if (step == 0) continue;
+		int clocksNoise = (ch == 2 && (c->noise & 3) == 3);
+		int isQuiet = (c->attenuation[ch] == 15 && !clocksNoise && ch < 3);
+		for (int i = 0;i < n;i++) {
+			phase += step;
+			LONG64 toggles = phase >> 32;
+			if (toggles == 0) continue;
+			if (isQuiet) { 															// Nothing to hear, keep count
+				c->output[ch] ^= (toggles & 1);
+			} else {
+				LONG64 start = phase - step;
+				for (LONG64 k = 1;k <= toggles;k++) {
+					int p = (int)((((k << 32) - start) * SN_KERNEL_PHASES) / step);
+					if (p >= SN_KERNEL_PHASES) p = SN_KERNEL_PHASES-1;
+					if (ch < 3) {
+						c->output[ch] ^= 1;
+						_SNSetLevel(c,buffer,ch,i,p);
+						if (clocksNoise) _SNNoiseClock(c,buffer,i,p);
+					} else {
+						_SNNoiseClock(c,buffer,i,p);
+					}
+				}
+			}
+			phase &= 0xFFFFFFFF;
+		}
+		c->phase[ch] = phase;
+	}
+}
+
+// *******************************************************************************************************************************
+//									Make stereo samples, left (chip 0) first
+// *******************************************************************************************************************************
+
+void SNEngineRender(struct _SNEngine *e,short *stereo,int samples) {
+	while (samples > 0) {
+		int n = (samples > SN_MAX_RENDER) ? SN_MAX_RENDER : samples;
+		for (int side = 0;side < 2;side++) {
+			int *buffer = e->buffer[side];
+			_SNRenderChip(&e->chip[side],buffer,n);
+			int sum = e->integrator[side];
+			for (int i = 0;i < n;i++) {
+				sum += buffer[i];
+				int s = sum >> 15;
+				stereo[i*2+side] = (s > 32767) ? 32767 : (s < -32768 ? -32768 : s);
+			}
+			e->integrator[side] = sum;
+			memmove(buffer,buffer+n,SN_KERNEL_WIDTH*sizeof(int)); 					// Steps not yet finished
+			memset(buffer+SN_KERNEL_WIDTH,0,n*sizeof(int));
+		}
+		stereo += n*2;samples -= n;
+	}
+}
+
+// *******************************************************************************************************************************
+//
+//		CPU side. Writes go in a single producer, single consumer ring with the cycle count ; the cycle count is
+//		published at the end of each frame so the audio callback knows how far the CPU has got. The engine is set up
+//		once, before the audio device is opened ; after that resets are register writes, through the queue.
+//
+// *******************************************************************************************************************************
+
+static int isSetUp = 0;
+
+void SNReset(void) {
+	if (isSetUp) return;
+	isSetUp = 1;
+	SNEngineReset(&playback);
+	SDL_AtomicSet(&queueHead,0);SDL_AtomicSet(&queueTail,0);
+	SDL_AtomicSet(&silenceRequest,0);
+}
+
+static void _SNProduce(LONG64 cycle);
+
+void SNWrite(int chip,int data) {
+	if (deviceMode != SN_DEVICE_QUEUED) { 											// Engine isn't shared
+		if (deviceMode == SN_DEVICE_SYNC) _SNProduce(CPUGetCycleCount());
+		SNEngineWrite(&playback,chip,data);
+		return;
+	}
+	int head = SDL_AtomicGet(&queueHead);
+	if (head - SDL_AtomicGet(&queueTail) >= SN_QUEUE_SIZE) return; 				// Not being played, e.g. no device
+	struct _SNWrite *w = &queue[head & (SN_QUEUE_SIZE-1)];
+	w->cycle = (LONG32)CPUGetCycleCount();w->chip = chip;w->data = data;
+	SDL_MemoryBarrierRelease();
+	SDL_AtomicSet(&queueHead,head+1);
+}
+
+void SNSync(void) {
+	if (deviceMode == SN_DEVICE_SYNC) {
+		_SNProduce(CPUGetCycleCount());
+		return;
+	}
+	SDL_AtomicSet(&publishedCycle,(int)(LONG32)CPUGetCycleCount());
+}
+
+void SNSilence(void) { 																// Debugger stopped, all off
+	if (deviceMode == SN_DEVICE_QUEUED) {
+		SDL_AtomicSet(&silenceRequest,1);
+		return;
+	}
+	for (int chip = 0;chip < 2;chip++) {
+		for (int ch = 0;ch < 4;ch++) SNEngineWrite(&playback,chip,0x9F | (ch << 5));
+	}
+	SDL_AtomicSet(&isStopped,1); 													// Running dry isn't an underrun
+}
+
+// *******************************************************************************************************************************
+//
+//		Audio callback. It plays SN_LATENCY cycles behind the CPU, applying each write when its cycle comes up, and
+//		jumps if it gets too far from that (warp, or the CPU stopped).
+//
+// *******************************************************************************************************************************
+
+static void _SNAudioRing(short *stereo,int samples);
+
+void SNAudioRender(short *stereo,int samples) {
+	if (deviceMode == SN_DEVICE_SYNC) {
+		_SNAudioRing(stereo,samples);
+		return;
+	}
+	if (SDL_AtomicGet(&silenceRequest)) {
+		SDL_AtomicSet(&silenceRequest,0);
+		for (int chip = 0;chip < 2;chip++) {
+			for (int ch = 0;ch < 4;ch++) SNEngineWrite(&playback,chip,0x9F | (ch << 5));
+		}
+	}
+	LONG32 now = (LONG32)SDL_AtomicGet(&publishedCycle);
+	int lag = (int)(now - (LONG32)(audioTime >> 16));
+	if (lag > SN_MAX_LAG || lag < SN_LATENCY - SN_MAX_LAG) { 						// Resynchronise
+		audioTime = (LONG64)(LONG32)(now - SN_LATENCY) << 16;
+	}
+	while (samples > 0) {
+		LONG32 time = (LONG32)(audioTime >> 16);
+		int n = samples;
+		int tail = SDL_AtomicGet(&queueTail);
+		while (tail != SDL_AtomicGet(&queueHead)) {
+			SDL_MemoryBarrierAcquire();
+			struct _SNWrite *w = &queue[tail & (SN_QUEUE_SIZE-1)];
+			int due = (int)(w->cycle - time);
+			if (due > 0) { 															// Play up to it
+				LONG64 toGo = (((LONG64)due << 16) + CYCLES_PER_SAMPLE - 1) / CYCLES_PER_SAMPLE;
+				if (toGo < (LONG64)n) n = (int)toGo;
+				break;
+			}
+			SNEngineWrite(&playback,w->chip,w->data);
+			tail++;
+		}
+		SDL_AtomicSet(&queueTail,tail);
+		SNEngineRender(&playback,stereo,n);
+		audioTime += n * CYCLES_PER_SAMPLE;
+		stereo += n*2;samples -= n;
+	}
+}
+
+// *******************************************************************************************************************************
+//
+//		Options, read on every reset but only used when the sound card is opened. audiosync paces the emulation by the
+//		sound card's buffer rather than the timer, so the two clocks can't drift apart.
+//
+// *******************************************************************************************************************************
+
+void SNSetAudioSync(int isOn) {
+	wantAudioSync = (isOn != 0);
+}
+
+void SNSetBufferSize(int samples) {
+	bufferSize = samples;
+}
+
+int SNGetBufferSize(void) {
+	return bufferSize;
+}
+
+void SNAudioOpened(int samples) {
+	bufferSize = samples; 															// What it actually got
+	targetFill = bufferSize * SN_TARGET_BUFFERS;
+	if (targetFill < SN_SAMPLE_RATE / FRAME_RATE) targetFill = SN_SAMPLE_RATE / FRAME_RATE; // At least a frame of them
+	SDL_AtomicSet(&ringHead,0);SDL_AtomicSet(&ringTail,0);
+	SDL_AtomicSet(&underruns,0);SDL_AtomicSet(&isStopped,0);SDL_AtomicSet(&hasStarted,0);
+	deviceMode = wantAudioSync ? SN_DEVICE_SYNC : SN_DEVICE_QUEUED;
+}
+
+void SNSetMute(int muted) { 														// Warp, nothing is made.
+	isMuted = muted;
+}
+
+// *******************************************************************************************************************************
+//
+//		audiosync. Samples are made up to the cycle count and go through a resampler into the ring. The resampler
+//		runs up to SN_MAX_ADJUST fast or slow to keep the ring at its target, so small differences between the sound
+//		card and the pacing (or a slow frame) are absorbed without underruns or latency creeping up.
+//
+// *******************************************************************************************************************************
+
+static void _SNResample(short *in,int n) {
+	int head = SDL_AtomicGet(&ringHead);
+	int space = SN_RING_SIZE - (head - SDL_AtomicGet(&ringTail));
+	int dropped = 0;
+	for (int i = 0;i < n;i++) {
+		while (resamplePos < 0x10000) { 											// Outputs between last and this one
+			if (space > 0) {
+				short *out = ring + (head & (SN_RING_SIZE-1)) * 2;
+				for (int side = 0;side < 2;side++) {
+					out[side] = resampleLast[side] + (int)(((LONG64)(in[i*2+side] - resampleLast[side]) * resamplePos) >> 16);
+				}
+				head++;space--;
+			} else {
+				dropped++;
+			}
+			resamplePos += resampleStep;
+		}
+		resamplePos -= 0x10000;
+		resampleLast[0] = in[i*2];resampleLast[1] = in[i*2+1];
+	}
+	if (dropped != 0) overruns++;
+	SDL_MemoryBarrierRelease();
+	SDL_AtomicSet(&ringHead,head);
+}
+
+static void _SNProduce(LONG64 cycle) {
+	static short buffer[SN_MAX_RENDER*2];
+	if (SDL_AtomicGet(&isStopped) || !hasProduced || isMuted) { 					// Start again from here
+		producedTime = cycle << 16;hasProduced = -1;
+		SDL_AtomicSet(&isStopped,isMuted);
+		return;
+	}
+	if ((cycle << 16) < producedTime) { 											// Gone back, start again
+		producedTime = cycle << 16;
+		return;
+	}
+	LONG64 samples = ((cycle << 16) - producedTime) / CYCLES_PER_SAMPLE;
+	if (samples == 0) return;
+	producedTime += samples * CYCLES_PER_SAMPLE;
+	if (samples > SN_RING_SIZE) samples = SN_RING_SIZE; 							// Single stepping, say
+	while (samples > 0) {
+		int n = (samples > SN_MAX_RENDER) ? SN_MAX_RENDER : (int)samples;
+		SNEngineRender(&playback,buffer,n);
+		_SNResample(buffer,n);
+		samples -= n;
+	}
+	int fill = SDL_AtomicGet(&ringHead) - SDL_AtomicGet(&ringTail); 				// Steer towards the target
+	averageFill = averageFill * 0.9 + fill * 0.1;
+	int adjust = (int)((averageFill - targetFill) * SN_MAX_ADJUST / targetFill);
+	adjust = (adjust > SN_MAX_ADJUST) ? SN_MAX_ADJUST : (adjust < -SN_MAX_ADJUST ? -SN_MAX_ADJUST : adjust);
+	resampleStep = 0x10000 + adjust; 												// Too full, fewer samples
+	if (resampleStep < minimumStep) minimumStep = resampleStep;
+	if (resampleStep > maximumStep) maximumStep = resampleStep;
+}
+
+static void _SNAudioRing(short *stereo,int samples) { 								// On the audio thread
+	int tail = SDL_AtomicGet(&ringTail);
+	int available = SDL_AtomicGet(&ringHead) - tail;
+	SDL_MemoryBarrierAcquire();
+	int n = (available < samples) ? available : samples;
+	for (int i = 0;i < n;i++) {
+		short *in = ring + ((tail + i) & (SN_RING_SIZE-1)) * 2;
+		stereo[i*2] = in[0];stereo[i*2+1] = in[1];
+	}
+	SDL_AtomicSet(&ringTail,tail+n);
+	if (n < samples) {
+		memset(stereo+n*2,0,(samples-n)*2*sizeof(short));
+		if (SDL_AtomicGet(&hasStarted) && !SDL_AtomicGet(&isStopped)) SDL_AtomicAdd(&underruns,1);
+	}
+	if (n > 0) SDL_AtomicSet(&hasStarted,1);
+}
+
+// *******************************************************************************************************************************
+//
+//		Wait until the ring is down to its target. Returns 0 if not in audiosync, or the sound card isn't taking
+//		samples, in which case the timer paces until it does.
+//
+// *******************************************************************************************************************************
+
+int SNAudioPace(void) {
+	if (deviceMode != SN_DEVICE_SYNC || isMuted) return 0;
+	if (stalledTail == SDL_AtomicGet(&ringTail)) return 0; 							// Still not taking any
+	stalledTail = -1;
+	LONG64 frequency = SDL_GetPerformanceFrequency();
+	LONG64 start = SDL_GetPerformanceCounter();
+	for (;;) {
+		int excess = SDL_AtomicGet(&ringHead) - SDL_AtomicGet(&ringTail) - targetFill;
+		if (excess <= 0) return -1;
+		LONG64 now = SDL_GetPerformanceCounter();
+		if (now - start > frequency * SN_PACE_TIMEOUT / 1000) {
+			stalledTail = SDL_AtomicGet(&ringTail);
+			return 0;
+		}
+		GFXSleepUntil(now + excess * frequency / SN_SAMPLE_RATE);
+	}
+}
+
+// *******************************************************************************************************************************
+//												Report at the end of the run
+// *******************************************************************************************************************************
+
+void SNReport(void) {
+	if (deviceMode != SN_DEVICE_SYNC) return;
+	printf("Audio sync : %d sample buffer, %.1fms waiting on average, %d underruns, %d overruns, resampled %+.2f%% to %+.2f%%\n",
+			bufferSize,1000.0 * averageFill / SN_SAMPLE_RATE,SDL_AtomicGet(&underruns),overruns,
+			100.0 * (0x10000 - maximumStep) / 0x10000,100.0 * (0x10000 - minimumStep) / 0x10000);
+}
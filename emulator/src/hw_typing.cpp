@@ -0,0 +1,100 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		hw_typing.cpp
+//		Purpose:	Typing host text, converted to PS/2 make/break sequences, for pasting and type@<file>
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "hardware.h"
+#include "asciitops2.h"
+
+static char *typeBuffer = NULL; 													// Text waiting to be typed
+static int typeSize = 0,typePosition = 0,typeAllocated = 0;
+static int typeDelay = 0; 															// Frames before starting
+static int lineQuiet = 0,lineLimit = 0; 											// Quiet frames wanted after a line, most wait
+static LONG64 nextCharacter = 0; 													// Cycle count for the next character
+
+// *******************************************************************************************************************************
+//									Add text to be typed, after waiting some frames
+// *******************************************************************************************************************************
+
+void HWTypeText(const char *text,int length,int delayFrames) {
+	if (typePosition == typeSize) typePosition = typeSize = 0; 						// Finished, so start again
+	if (typeSize + length > typeAllocated) {
+		typeAllocated = typeSize + length + 4096;
+		typeBuffer = (char *)realloc(typeBuffer,typeAllocated);
+	}
+	memcpy(typeBuffer+typeSize,text,length);
+	typeSize += length;
+	if (delayFrames > typeDelay) typeDelay = delayFrames;
+}
+
+int HWTypeFile(const char *fileName,int delayFrames) {
+	FILE *f = fopen(fileName,"rb");
+	if (f == NULL) return 0;
+	char buffer[4096];
+	int n;
+	while ((n = fread(buffer,1,sizeof(buffer),f)) > 0) HWTypeText(buffer,n,delayFrames);
+	fclose(f);
+	return -1;
+}
+
+void HWTypeFrame(int textChanged) { 												// Count down the delays
+	if (typeDelay > 0) typeDelay--;
+	if (lineQuiet > 0) { 															// Until the text display is quiet
+		lineQuiet = textChanged ? HW_TYPE_LINE_DELAY : lineQuiet-1;
+		if (--lineLimit == 0) lineQuiet = 0;
+	}
+}
+
+int HWTypeBusy(void) { 																// Still text to type ?
+	return typePosition < typeSize;
+}
+
+void HWTypeReset(void) {
+	typePosition = typeSize = typeDelay = lineQuiet = 0;
+	nextCharacter = 0;
+}
+
+// *******************************************************************************************************************************
+//
+//		Get the PS/2 bytes for the next character, returns how many (at most HW_TYPE_MAX_BYTES), 0 if there isn't one.
+//		Shifted characters are wrapped in left shift, extended keys prefixed with $E0. Characters with no key are skipped.
+//		The kernel takes keys from the FIFO straight away, but can't keep up with them all at once, so characters are
+//		spaced out a little, and after each line it waits until the text display has stopped changing (the line has been
+//		entered, any messages printed and the screen scrolled) ; otherwise keys are lost.
+//
+// *******************************************************************************************************************************
+
+int HWTypeNext(int *bytes) {
+	if (CPUGetCycleCount() < nextCharacter) return 0;
+	while (typeDelay == 0 && lineQuiet == 0 && typePosition < typeSize) {
+		int c = typeBuffer[typePosition++] & 0xFF;
+		if (c == '\n') { 															// Host line endings, LF or CRLF
+			c = 13;
+			lineQuiet = HW_TYPE_LINE_DELAY; 										// Give it time to deal with the line
+			lineLimit = HW_TYPE_LINE_LIMIT;
+		} else if (c == 13) continue;
+		int code = (c < 128) ? asciiToScanCode[c] : 0;
+		if (code == 0) continue;
+		int n = 0;
+		nextCharacter = CPUGetCycleCount() + HW_TYPE_CHAR_CYCLES;
+		if (code & 0x100) bytes[n++] = 0x12; 										// Left shift down
+		if (code & 0x80) bytes[n++] = 0xE0;
+		bytes[n++] = code & 0x7F; 													// Make
+		if (code & 0x80) bytes[n++] = 0xE0;
+		bytes[n++] = 0xF0;bytes[n++] = code & 0x7F; 								// Break
+		if (code & 0x100) { bytes[n++] = 0xF0;bytes[n++] = 0x12; } 					// Left shift up
+		return n;
+	}
+	return 0;
+}
@@ -0,0 +1,361 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_capture.cpp
+//		Purpose:	Capturing the display as RGBA, PPM or PNG files, or a y4m stream (which can be a pipe), and the sound
+//					as a WAV file. Both are in emulated time, so capture can run in warp or headless. Frames are only
+//					drawn when the display hash changes, and are encoded by a writer thread.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "sys_debug_system.h"
+#include "sys_hash.h"
+#include "sys_capture.h"
+#include "hw_sn76489.h"
+
+struct _Frame {
+	int 	number; 																// Frame number since capture started
+	BYTE8 	rgba[CAP_WIDTH*CAP_HEIGHT*4];
+};
+
+static int format = -1; 															// CAP_RGBA etc., -1 not capturing
+static char fileStem[256],fileExtension[16]; 										// Numbered files are <stem>_nnnnnn<ext>
+static FILE *streamFile = NULL; 													// y4m output
+static int isPipe = 0;
+static int frameNumber = 0; 														// Frames since capture started
+static LONG64 lastHash;
+
+static struct _Frame *queue[CAP_QUEUE]; 											// Frames waiting to be written
+static int queueHead = 0,queueCount = 0,isStopping = 0;
+static SDL_mutex *queueLock = NULL;
+static SDL_cond *hasFrame,*hasSpace;
+static SDL_Thread *writerThread = NULL;
+
+static BYTE8 *yuvFrame = NULL; 														// Last y4m frame, and its number
+static int yuvNumber = -1;
+static BYTE8 *pngBuffer = NULL;
+static LONG32 crcTable[256];
+
+static FILE *wavFile = NULL; 														// wav@<file>
+static LONG64 audioStartCycle,audioSamples; 										// Cycle count at sample 0, samples made
+static struct _SNEngine sound; 														// Own copy of the chips, not the sound card's
+static int isSoundReset = 0;
+static short audioBuffer[CAP_AUDIO_BUFFER*2]; 										// Stereo
+static int audioCount;
+
+static int _CAPWriterThread(void *data);
+static void _CAPWriteY4MFrame(int repeats);
+
+// *******************************************************************************************************************************
+//
+//		Start capturing frames. The extension decides the format : .rgba .ppm and .png write a numbered file for each
+//		frame that is different, .y4m writes every frame to one file, or to a command if the name starts with '|'.
+//
+// *******************************************************************************************************************************
+
+static void _CAPCloseFrames(void) {
+	if (format < 0) return;
+	SDL_LockMutex(queueLock); 														// Let the writer finish the queue
+	isStopping = -1;
+	SDL_CondSignal(hasFrame);
+	SDL_UnlockMutex(queueLock);
+	SDL_WaitThread(writerThread,NULL);
+	writerThread = NULL;
+	if (format == CAP_Y4M) { 														// Last frame, to the end
+		if (yuvNumber >= 0) _CAPWriteY4MFrame(frameNumber - yuvNumber);
+		if (isPipe) pclose(streamFile); else fclose(streamFile);
+		streamFile = NULL;
+	}
+	printf("Captured %d frames\n",frameNumber);
+	format = -1;
+}
+
+int CAPOpen(const char *fileName) {
+	if (format >= 0) return -1; 													// Already open (e.g. after reset)
+	isPipe = (fileName[0] == '|');
+	const char *dot = strrchr(fileName,'.');
+	if (isPipe || dot == NULL || strlen(dot) >= sizeof(fileExtension)) dot = fileName + strlen(fileName);
+	snprintf(fileStem,sizeof(fileStem),"%.*s",(int)(dot-fileName),fileName);
+	for (int i = 0;i <= (int)strlen(dot);i++) fileExtension[i] = tolower(dot[i]);
+	format = -1;
+	if (strcmp(fileExtension,".rgba") == 0) format = CAP_RGBA;
+	if (strcmp(fileExtension,".ppm") == 0) format = CAP_PPM;
+	if (strcmp(fileExtension,".png") == 0) format = CAP_PNG;
+	if (isPipe || strcmp(fileExtension,".y4m") == 0) format = CAP_Y4M;
+	if (format < 0) return 0;
+	if (format == CAP_Y4M) {
+		streamFile = isPipe ? popen(fileName+1,"w") : fopen(fileName,"wb");
+		if (streamFile == NULL) { format = -1;return 0; }
+		fprintf(streamFile,"YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",CAP_WIDTH,CAP_HEIGHT,CAP_FRAME_RATE);
+		if (yuvFrame == NULL) yuvFrame = (BYTE8 *)malloc(CAP_WIDTH*CAP_HEIGHT*3/2);
+		yuvNumber = -1;
+	}
+	if (queueLock == NULL) { 														// First time
+		queueLock = SDL_CreateMutex();
+		hasFrame = SDL_CreateCond();hasSpace = SDL_CreateCond();
+		for (int i = 0;i < CAP_QUEUE;i++) queue[i] = (struct _Frame *)malloc(sizeof(struct _Frame));
+	}
+	queueHead = queueCount = isStopping = 0;
+	frameNumber = 0;
+	writerThread = SDL_CreateThread(_CAPWriterThread,"capture writer",NULL);
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		Start capturing sound. The chips are run here, with every register write applied at its cycle count, rather
+//		than taken from the sound card, so it is the same at any speed.
+//
+// *******************************************************************************************************************************
+
+static void _CAPWavHeader(FILE *f,LONG32 dataBytes) {
+	BYTE8 h[44];
+	LONG32 values[] = { 36+dataBytes,16,(2 << 16)|1,CAP_SAMPLE_RATE,CAP_SAMPLE_RATE*4,(16 << 16)|4,dataBytes };
+	memcpy(h,"RIFF....WAVEfmt ....................data....",44);
+	int offsets[] = { 4,16,20,24,28,32,40 };
+	for (int i = 0;i < 7;i++) {
+		for (int b = 0;b < 4;b++) h[offsets[i]+b] = (values[i] >> (b*8)) & 0xFF;
+	}
+	fseek(f,0,SEEK_SET);
+	fwrite(h,1,44,f);
+}
+
+static void _CAPCloseAudio(void) {
+	if (wavFile == NULL) return;
+	fwrite(audioBuffer,sizeof(short)*2,audioCount,wavFile);
+	_CAPWavHeader(wavFile,audioSamples*4);
+	fclose(wavFile);
+	wavFile = NULL;
+}
+
+int CAPOpenAudio(const char *fileName) {
+	if (wavFile != NULL) return -1; 												// Already open (e.g. after reset)
+	wavFile = fopen(fileName,"wb");
+	if (wavFile == NULL) return 0;
+	_CAPWavHeader(wavFile,0);
+	audioStartCycle = CPUGetCycleCount();
+	audioSamples = 0;audioCount = 0;
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//				Make samples up to the given cycle count, then write a register. The chips are kept up to date when
+//				not recording, so it starts with the right sound.
+// *******************************************************************************************************************************
+
+static void _CAPAudioTo(LONG64 cycle) {
+	LONG64 target = (cycle - audioStartCycle) * CAP_SAMPLE_RATE / CAP_CYCLE_RATE;
+	while (audioSamples < target) {
+		int n = CAP_AUDIO_BUFFER - audioCount;
+		LONG64 left = target - audioSamples;
+		if ((LONG64)n > left) n = (int)left;
+		SNEngineRender(&sound,audioBuffer+audioCount*2,n);
+		audioCount += n;audioSamples += n;
+		if (audioCount == CAP_AUDIO_BUFFER) {
+			fwrite(audioBuffer,sizeof(short)*2,audioCount,wavFile);
+			audioCount = 0;
+		}
+	}
+}
+
+void CAPSoundWrite(int chip,int data) {
+	if (isSoundReset == 0) {
+		isSoundReset = -1;
+		SNEngineReset(&sound);
+	}
+	if (wavFile != NULL) _CAPAudioTo(CPUGetCycleCount());
+	SNEngineWrite(&sound,chip,data);
+}
+
+// *******************************************************************************************************************************
+//
+//		End of a frame. If the display hash has changed, the display is drawn and copied (without the border, one pixel
+//		for each display pixel) into the queue, waiting if the writer has fallen behind.
+//
+// *******************************************************************************************************************************
+
+static void _CAPGrab(int number) {
+	static int address[4] = { 0,0,0,0 };
+	DBGXRender(address,1);
+	SDL_Surface *surface = GFXGetSurface();
+	if (surface == NULL || surface->format->BytesPerPixel != 4) return;
+	SDL_LockMutex(queueLock);
+	while (queueCount == CAP_QUEUE) SDL_CondWait(hasSpace,queueLock);
+	struct _Frame *f = queue[(queueHead + queueCount) % CAP_QUEUE]; 				// Not the writer's, until queued
+	SDL_UnlockMutex(queueLock);
+	f->number = number;
+	int x1 = WIN_WIDTH/2 - CAP_WIDTH*CAP_SCALE/2,y1 = WIN_HEIGHT/2 - CAP_HEIGHT*CAP_SCALE/2;
+	BYTE8 *p = f->rgba;
+	for (int y = 0;y < CAP_HEIGHT;y++) {
+		Uint32 *row = (Uint32 *)((BYTE8 *)surface->pixels + (y1 + y*CAP_SCALE) * surface->pitch) + x1;
+		for (int x = 0;x < CAP_WIDTH;x++) {
+			SDL_GetRGB(row[x*CAP_SCALE],surface->format,p,p+1,p+2);
+			p[3] = 0xFF;p += 4;
+		}
+	}
+	SDL_LockMutex(queueLock);
+	queueCount++;
+	SDL_CondSignal(hasFrame);
+	SDL_UnlockMutex(queueLock);
+}
+
+void CAPEndFrame(void) {
+	if (wavFile != NULL) _CAPAudioTo(CPUGetCycleCount());
+	if (format < 0) return;
+	LONG64 hash = HSHDisplayHash();
+	if (frameNumber == 0 || hash != lastHash) {
+		lastHash = hash;
+		_CAPGrab(frameNumber);
+	}
+	frameNumber++;
+}
+
+void CAPClose(void) {
+	_CAPCloseFrames();
+	_CAPCloseAudio();
+}
+
+// *******************************************************************************************************************************
+//
+//		PNG, with the image data stored rather than compressed, which is much quicker and needs no library. Still
+//		a valid zlib stream : a header, 64k stored blocks, and the Adler32 checksum.
+//
+// *******************************************************************************************************************************
+
+static LONG32 _CAPCrc(LONG32 crc,const BYTE8 *data,int length) {
+	if (crcTable[1] == 0) {
+		for (LONG32 n = 0;n < 256;n++) {
+			LONG32 c = n;
+			for (int k = 0;k < 8;k++) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			crcTable[n] = c;
+		}
+	}
+	crc = crc ^ 0xFFFFFFFF;
+	while (length-- > 0) crc = crcTable[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFF;
+}
+
+static void _CAPPut32(BYTE8 *p,LONG32 n) {
+	p[0] = n >> 24;p[1] = n >> 16;p[2] = n >> 8;p[3] = n;
+}
+
+static void _CAPPngChunk(FILE *f,const char *type,BYTE8 *data,int length) { 		// data has 8 bytes free before it
+	BYTE8 crc[4];
+	_CAPPut32(data-8,length);
+	memcpy(data-4,type,4);
+	_CAPPut32(crc,_CAPCrc(0,data-4,length+4));
+	fwrite(data-8,1,length+8,f);
+	fwrite(crc,1,4,f);
+}
+
+static void _CAPWritePNG(FILE *f,struct _Frame *frame) {
+	const int rowSize = 1+CAP_WIDTH*3,rawSize = rowSize*CAP_HEIGHT;
+	const int blocks = (rawSize + 65534) / 65535;
+	if (pngBuffer == NULL) pngBuffer = (BYTE8 *)malloc(rawSize*2 + blocks*5 + 64);
+	BYTE8 *raw = pngBuffer + rawSize + blocks*5 + 32; 								// Filtered image, 'none' filter
+	for (int y = 0;y < CAP_HEIGHT;y++) {
+		BYTE8 *s = frame->rgba + y*CAP_WIDTH*4,*d = raw + y*rowSize;
+		*d++ = 0;
+		for (int x = 0;x < CAP_WIDTH;x++) { *d++ = s[0];*d++ = s[1];*d++ = s[2];s += 4; }
+	}
+	fwrite("\x89PNG\r\n\x1a\n",1,8,f);
+	BYTE8 *data = pngBuffer + 8; 													// IHDR
+	_CAPPut32(data,CAP_WIDTH);_CAPPut32(data+4,CAP_HEIGHT);
+	data[8] = 8;data[9] = 2;data[10] = data[11] = data[12] = 0; 					// 8 bit RGB
+	_CAPPngChunk(f,"IHDR",data,13);
+	BYTE8 *z = data; 																// IDAT, zlib stream
+	*z++ = 0x78;*z++ = 0x01;
+	LONG32 a = 1,b = 0;
+	for (int pos = 0;pos < rawSize;pos += 65535) {
+		int n = (rawSize - pos > 65535) ? 65535 : rawSize - pos;
+		*z++ = (pos + n == rawSize) ? 1 : 0;
+		*z++ = n & 0xFF;*z++ = n >> 8;*z++ = ~n & 0xFF;*z++ = (~n >> 8) & 0xFF;
+		memmove(z,raw+pos,n);
+		for (int i = 0;i < n;i++) { a = (a + z[i]) % 65521;b = (b + a) % 65521; }
+		z += n;
+	}
+	_CAPPut32(z,(b << 16) | a);z += 4;
+	_CAPPngChunk(f,"IDAT",data,z-data);
+	_CAPPngChunk(f,"IEND",data,0);
+}
+
+// *******************************************************************************************************************************
+//								y4m, 4:2:0 full range (JPEG) YCbCr, chroma from each 2x2 block
+// *******************************************************************************************************************************
+
+static void _CAPConvertY4M(struct _Frame *frame) {
+	BYTE8 *yp = yuvFrame,*up = yuvFrame+CAP_WIDTH*CAP_HEIGHT,*vp = up+CAP_WIDTH*CAP_HEIGHT/4;
+	BYTE8 *s = frame->rgba;
+	for (int i = 0;i < CAP_WIDTH*CAP_HEIGHT;i++) {
+		*yp++ = (77*s[0] + 150*s[1] + 29*s[2]) >> 8;
+		s += 4;
+	}
+	for (int y = 0;y < CAP_HEIGHT;y += 2) {
+		for (int x = 0;x < CAP_WIDTH;x += 2) {
+			int r = 0,g = 0,b = 0;
+			for (int i = 0;i < 4;i++) {
+				BYTE8 *p = frame->rgba + ((y+i/2)*CAP_WIDTH + x+(i&1))*4;
+				r += p[0];g += p[1];b += p[2];
+			}
+			*up++ = ((-43*r - 85*g + 128*b) >> 10) + 128;
+			*vp++ = ((128*r - 107*g - 21*b) >> 10) + 128;
+		}
+	}
+}
+
+static void _CAPWriteY4MFrame(int repeats) {
+	while (repeats-- > 0) {
+		fwrite("FRAME\n",1,6,streamFile);
+		fwrite(yuvFrame,1,CAP_WIDTH*CAP_HEIGHT*3/2,streamFile);
+	}
+}
+
+// *******************************************************************************************************************************
+//						Writer thread. A y4m frame is written when the next one arrives, as often as it lasted
+// *******************************************************************************************************************************
+
+static void _CAPWrite(struct _Frame *frame) {
+	char name[300];
+	if (format == CAP_Y4M) {
+		if (yuvNumber >= 0) _CAPWriteY4MFrame(frame->number - yuvNumber);
+		_CAPConvertY4M(frame);
+		yuvNumber = frame->number;
+		return;
+	}
+	snprintf(name,sizeof(name),"%s_%06d%s",fileStem,frame->number,fileExtension);
+	FILE *f = fopen(name,"wb");
+	if (f == NULL) return;
+	if (format == CAP_PPM) {
+		fprintf(f,"P6 %d %d 255\n",CAP_WIDTH,CAP_HEIGHT);
+		for (int i = 0;i < CAP_WIDTH*CAP_HEIGHT;i++) fwrite(frame->rgba+i*4,1,3,f);
+	}
+	if (format == CAP_RGBA) fwrite(frame->rgba,1,CAP_WIDTH*CAP_HEIGHT*4,f);
+	if (format == CAP_PNG) _CAPWritePNG(f,frame);
+	fclose(f);
+}
+
+static int _CAPWriterThread(void *data) {
+	for (;;) {
+		SDL_LockMutex(queueLock);
+		while (queueCount == 0 && !isStopping) SDL_CondWait(hasFrame,queueLock);
+		if (queueCount == 0) { SDL_UnlockMutex(queueLock);break; } 				// Stopping, and all written
+		struct _Frame *frame = queue[queueHead];
+		SDL_UnlockMutex(queueLock);
+		_CAPWrite(frame);
+		SDL_LockMutex(queueLock);
+		queueHead = (queueHead + 1) % CAP_QUEUE;
+		queueCount--;
+		SDL_CondSignal(hasSpace);
+		SDL_UnlockMutex(queueLock);
+	}
+	return 0;
+}
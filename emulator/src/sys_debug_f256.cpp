@@ -17,8 +17,7 @@
 #include "sys_processor.h"
 #include "debugger.h"
 #include "hardware.h"
-
-#include "processor/__6502mnemonics.h"
+#include "sys_disasm.h"
 
 #define DBGC_ADDRESS 	(0x0F0)														// Colour scheme.
 #define DBGC_DATA 		(0x0FF)														// (Background is in main.c)
@@ -90,15 +89,19 @@ void DBGXRender(int *address,int showDisplay) {
 		GFXNumber(GRID(34,1),io & 3,16,1,GRIDSIZE,DBGC_DATA,-1);
 	}
 	for (int i = 0;i < 8;i++) {
-		GFXNumber(GRID(30,i+2),i,16,1,GRIDSIZE,DBGC_ADDRESS,-1);
+		GFXNumber(GRID(30,i+2),i,16,1,GRIDSIZE,HMPSlotActivity(i) ? DBGC_HIGHLIGHT:DBGC_ADDRESS,-1);	// Highlight if edited recently
 		GFXNumber(GRID(34,i+2),s->mapping[i] << 13,16,5,GRIDSIZE,DBGC_DATA,-1);
 	}
 
 	#define DN(v,w) GFXNumber(GRID(24,n++),v,16,w,GRIDSIZE,DBGC_DATA,-1)			// Helper macro
 
-	DN(s->a,2);DN(s->x,2);DN(s->y,2);DN(s->pc,4);DN(s->sp+0x100,4);DN(s->status,2);DN(s->cycles,4);
+	DN(s->a,2);DN(s->x,2);DN(s->y,2);DN(s->pc,4);DN(s->sp+0x100,4);DN(s->status,2);DN((int)(s->cycles & 0xFFFF),4);
 	DN(s->sign,1);DN(s->overflow,1);DN(s->brk,1);DN(s->decimal,1);DN(s->interruptDisable,1);DN(s->zero,1);DN(s->carry,1);
 
+	HMPRender(_GFXX(30),_GFXY(10),_GFXX(36)-_GFXX(30),_GFXY(14)-_GFXY(10)); 		// Physical memory heatmap
+	int thrash = HMPRenderStatus(buffer);
+	GFXString(GRID(16,14),buffer,GRIDSIZE,thrash ? 0xF00:DBGC_ADDRESS,-1);
+
 	n = 0;
 	int a = address[1];																// Dump Memory.
 	for (int row = 15;row < 23;row++) {
@@ -113,38 +116,22 @@ void DBGXRender(int *address,int showDisplay) {
 	}
 
 	int p = address[0];																// Dump program code. 
-	int opc;
+	int length;
 
 	for (int row = 0;row < 14;row++) {
+		const char *label = DISSymbol(p); 											// Label on its own line
+		if (label != NULL && row < 13) {
+			snprintf(buffer,21,"%s:",label);
+			GFXString(GRID(0,row),buffer,GRIDSIZE,DBGC_HIGHLIGHT,-1);
+			row++;
+		}
 		int isPC = (p == ((s->pc) & 0xFFFF));										// Tests.
 		int isBrk = (p == address[3]);
 		GFXNumber(GRID(0,row),p,16,4,GRIDSIZE,isPC ? DBGC_HIGHLIGHT:DBGC_ADDRESS,	// Display address / highlight / breakpoint
 																	isBrk ? 0xF00 : -1);
-		opc = CPUReadMemory(p);p = (p + 1) & 0xFFFF;								// Read opcode.
-		strcpy(buffer,_mnemonics[opc]);												// Work out the opcode.
-		char *at = strchr(buffer,'@');												// Look for '@'
-		if (at != NULL) {															// Operand ?
-			char hex[6],temp[32];	
-			if (at[1] == '1') {
-				sprintf(hex,"%02x",CPUReadMemory(p));
-				p = (p+1) & 0xFFFF;
-			}
-			if (at[1] == '2') {
-				sprintf(hex,"%02x%02x",CPUReadMemory(p+1),CPUReadMemory(p));
-				p = (p+2) & 0xFFFF;
-			}
-			if (at[1] == 'r') {
-				int addr = CPUReadMemory(p);
-				p = (p+1) & 0xFFFF;
-				if ((addr & 0x80) != 0) addr = addr-256;
-				sprintf(hex,"%04x",addr+p);
-			}
-			strcpy(temp,buffer);
-			strcpy(temp+(at-buffer),hex);
-			strcat(temp,at+2);
-			strcpy(buffer,temp);
-		}
-		GFXString(GRID(5,row),buffer,GRIDSIZE,isPC ? DBGC_HIGHLIGHT:DBGC_DATA,-1);	// Print the mnemonic
+		const char *text = DISDisassemble(p,&length); 								// Cached, with symbols
+		GFXString(GRID(5,row),text,GRIDSIZE,isPC ? DBGC_HIGHLIGHT:DBGC_DATA,-1);	// Print the mnemonic
+		p = (p + length) & 0xFFFF;
 	}
 
 	#endif 
@@ -162,6 +149,7 @@ void DBGXRender(int *address,int showDisplay) {
 		int ctrl = IOReadMemory(0,0xD000);
 		_DBGXResetColourCache();
 		SDL_Rect r;
+		LONG64 startTime = STSTime();
 		//
 		//		Do border
 		//
@@ -172,6 +160,7 @@ void DBGXRender(int *address,int showDisplay) {
 		//
 		r.x = x1;r.y = y1;r.w = xs*xSize*8;r.h=ys*ySize*8;
 		GFXRectangle(&r,(ctrl & 4) ? DBGXGetColour(0,0xD00D,0) : 0);
+		STSAddTime(STS_TIME_BACKGROUND,startTime);startTime = STSTime();
 		//
 		//		Tilemaps if Tile on. 
 		//
@@ -180,6 +169,7 @@ void DBGXRender(int *address,int showDisplay) {
 			if (IOReadMemory(0,0xD20C) & 1) DGBXRenderTilemap8(0xD20C,x1,y1,xSize*2,ySize*2);
 			if (IOReadMemory(0,0xD218) & 1) DGBXRenderTilemap8(0xD218,x1,y1,xSize*2,ySize*2);
 		}
+		STSAddTime(STS_TIME_TILEMAP,startTime);startTime = STSTime();
 		//
 		//		Bitmaps if Bitmap & Graphic on.
 		//
@@ -187,6 +177,7 @@ void DBGXRender(int *address,int showDisplay) {
 			if (IOReadMemory(0,0xD100) & 1) DGBXRenderBitmap(0xD100,x1,y1,xSize*2,ySize*2);
 			if (IOReadMemory(0,0xD108) & 1) DGBXRenderBitmap(0xD108,x1,y1,xSize*2,ySize*2);
 		}
+		STSAddTime(STS_TIME_BITMAP,startTime);startTime = STSTime();
 		//
 		//		Draw sprites
 		//
@@ -197,6 +188,7 @@ void DBGXRender(int *address,int showDisplay) {
 				}
 			}		
 		}
+		STSAddTime(STS_TIME_SPRITE,startTime);startTime = STSTime();
 		//
 		//		Draw text mode, possibly overlaid and scaled
 		//
@@ -243,7 +235,7 @@ void DBGXRender(int *address,int showDisplay) {
 			 	}
 			}
 		}
-
+		STSAddTime(STS_TIME_TEXT,startTime);
 	}
 }	
 
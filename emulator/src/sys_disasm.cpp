@@ -0,0 +1,261 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_disasm.cpp
+//		Purpose:	Cached, symbol aware disassembly. Instruction boundaries are indexed per physical page and rebuilt only
+//					when that page has been written, so the code panel can scroll backwards.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <unordered_map>
+#include "sys_processor.h"
+#include "sys_disasm.h"
+
+#include "processor/__6502mnemonics.h"
+
+LONG32 disPageVersion[DIS_PAGES]; 													// Bumped on every write to a page
+
+static std::unordered_map<int,std::string> symbols; 								// Physical address -> label
+static BYTE8 instructionLength[256];
+static int isInitialised = 0;
+
+struct _PageIndex {
+	LONG32 	version; 																// Page version this was built from
+	BYTE8 	isStart[8192]; 															// Non zero if an instruction starts here
+};
+
+static _PageIndex *pageIndex[DIS_PAGES];
+
+struct _CachedLine {
+	int 	physical; 																// Address decoded, -1 unused
+	WORD16 	address; 																// CPU address it was decoded at
+	LONG32 	version; 																// Page version(s) when decoded
+	LONG64 	mapKey; 																// MMU mapping when decoded
+	int 	length;
+	char 	text[DIS_TEXT_SIZE+1];
+};
+
+static _CachedLine lineCache[DIS_LINE_CACHE];
+
+// *******************************************************************************************************************************
+//									Set up, first time only, loading the kernel symbols
+// *******************************************************************************************************************************
+
+void DISReset(void) {
+	if (isInitialised) { DISInvalidateAll();return; }
+	isInitialised = 1;
+	for (int i = 0;i < 256;i++) { 													// Lengths from the operand markers
+		const char *m = _mnemonics[i];
+		instructionLength[i] = 1;
+		while ((m = strchr(m,'@')) != NULL) {
+			instructionLength[i] += (m[1] == '2') ? 2 : 1;
+			m++;
+		}
+	}
+	for (int i = 0;i < DIS_LINE_CACHE;i++) lineCache[i].physical = -1;
+	DISLoadSymbols(DIS_MONITOR_SYMBOLS); 											// Not an error if not built.
+	DISLoadSymbols(DIS_LOCKOUT_SYMBOLS);
+}
+
+void DISInvalidateAll(void) {
+	for (int i = 0;i < DIS_PAGES;i++) disPageVersion[i]++;
+}
+
+// *******************************************************************************************************************************
+//
+//		The debugger's disassembly is fine with every page being bumped when the CPU stops, so the plain run loop does
+//		not keep the versions. Run-ahead and the display hash want them kept as it runs, and say so here.
+//
+// *******************************************************************************************************************************
+
+static int versionsWanted = 0;
+
+void DISWantPageVersions(void) {
+	versionsWanted = -1;
+}
+
+int DISPageVersionsWanted(void) {
+	return versionsWanted;
+}
+
+// *******************************************************************************************************************************
+//
+//		Load labels from a 64tass listing (-L). Lines with code start .xxxx ; a label is an identifier followed by ':' after
+//		a tab. Addresses are CPU addresses, placed through the reset mapping, so $E000-$FFFF goes to the monitor page(s).
+//
+// *******************************************************************************************************************************
+
+static void _DISAddSymbol(int physical,const char *name) {
+	if (symbols.find(physical) == symbols.end()) symbols[physical] = name;		// First definition wins.
+}
+
+int DISLoadSymbols(const char *fileName) {
+	char line[512],name[64];
+	FILE *f = fopen(fileName,"r");
+	if (f == NULL) return 0;
+	int count = 0;
+	while (fgets(line,sizeof(line),f) != NULL) {
+		int address;
+		if (line[0] != '.' || sscanf(line+1,"%x",&address) != 1) continue;
+		for (char *p = line;*p != '\0';p++) {
+			if (*p == '\t' && (isalpha(p[1]) || p[1] == '_')) {
+				int n = 0;
+				p++;
+				while ((isalnum(*p) || *p == '_') && n < 63) name[n++] = *p++;
+				name[n] = '\0';
+				if (*p == ':') {
+					int slot = (address >> 13) & 7;
+					int offset = address & 0x1FFF;
+					_DISAddSymbol(((slot == 7 ? PAGE_MONITOR : slot) << 13) | offset,name);
+					if (slot == 7) _DISAddSymbol((0x7F << 13) | offset,name); 	// Flash boot copy.
+					count++;
+					break;
+				}
+				p--; 																// Not a label, keep looking.
+			}
+		}
+	}
+	fclose(f);
+	DISInvalidateAll();
+	printf("Loaded %d symbols from %s\n",count,fileName);
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//							Physical addresses of a label (there can be more than one), returns how many
+// *******************************************************************************************************************************
+
+int DISFindSymbol(const char *name,int *physical,int maxCount) {
+	int count = 0;
+	for (auto it = symbols.begin();it != symbols.end();++it) {
+		if (it->second == name && count < maxCount) physical[count++] = it->first;
+	}
+	return count;
+}
+
+// *******************************************************************************************************************************
+//												Symbol at a CPU address, or NULL
+// *******************************************************************************************************************************
+
+static const char *_DISPhysicalSymbol(int physical) {
+	if (physical < 0 || symbols.empty()) return NULL;
+	auto it = symbols.find(physical);
+	return (it == symbols.end()) ? NULL : it->second.c_str();
+}
+
+const char *DISSymbol(WORD16 address) {
+	return _DISPhysicalSymbol(CPUMapAddress(address));
+}
+
+// *******************************************************************************************************************************
+//
+//		Get the boundary index for a page, rebuilding it by a linear sweep if the page has been written. A label always
+//		starts an instruction, which resynchronises the sweep after embedded data.
+//
+// *******************************************************************************************************************************
+
+static _PageIndex *_DISGetIndex(int page) {
+	if (pageIndex[page] == NULL) {
+		pageIndex[page] = (_PageIndex *)malloc(sizeof(_PageIndex));
+		pageIndex[page]->version = disPageVersion[page]-1;
+	}
+	_PageIndex *pi = pageIndex[page];
+	if (pi->version != disPageVersion[page]) {
+		BYTE8 *memory = CPUAccessMemory() + (page << 13);
+		int next = 0;
+		for (int i = 0;i < 8192;i++) {
+			pi->isStart[i] = (i == next || _DISPhysicalSymbol((page << 13)+i) != NULL);
+			if (pi->isStart[i]) next = i + instructionLength[memory[i]];
+		}
+		pi->version = disPageVersion[page];
+	}
+	return pi;
+}
+
+// *******************************************************************************************************************************
+//													Step forwards and backwards
+// *******************************************************************************************************************************
+
+WORD16 DISNextInstruction(WORD16 address) {
+	return (address + instructionLength[CPUReadMemory(address)]) & 0xFFFF;
+}
+
+WORD16 DISPreviousInstruction(WORD16 address) {
+	for (int back = 1;back <= 3;back++) { 											// Only the last boundary can end here.
+		WORD16 candidate = (address - back) & 0xFFFF;
+		int physical = CPUMapAddress(candidate);
+		if (physical >= 0 && _DISGetIndex(physical >> 13)->isStart[physical & 0x1FFF]) {
+			if (DISNextInstruction(candidate) == address) return candidate;
+		}
+	}
+	return (address - 1) & 0xFFFF; 													// Data, or I/O, a byte at a time.
+}
+
+// *******************************************************************************************************************************
+//
+//					Disassemble one instruction, replacing absolute and branch targets with labels where known.
+//
+// *******************************************************************************************************************************
+
+static LONG64 _DISMapKey(void) {
+	LONG64 key = 0;
+	for (int i = 0;i < 8;i++) key = key * 131 + CPUMapAddress(i << 13);
+	return key;
+}
+
+static void _DISDecode(WORD16 address,char *text,int *length) {
+	char buffer[128],operand[32];
+	const char *m = _mnemonics[CPUReadMemory(address)];
+	int n = 0,p = (address+1) & 0xFFFF;
+	*length = instructionLength[CPUReadMemory(address)];
+	while (*m != '\0') {
+		if (*m != '@') { buffer[n++] = *m++;continue; }
+		int target = -1;
+		if (m[1] == '1') { 															// Byte operand
+			sprintf(operand,"%02x",CPUReadMemory(p));p = (p+1) & 0xFFFF;
+		}
+		if (m[1] == '2') { 															// Word operand
+			target = CPUReadMemory(p)+(CPUReadMemory((p+1) & 0xFFFF) << 8);p = (p+2) & 0xFFFF;
+			sprintf(operand,"%04x",target);
+		}
+		if (m[1] == 'r') { 															// Relative, from the end of the instruction
+			int offset = CPUReadMemory(p);p = (p+1) & 0xFFFF;
+			if (offset & 0x80) offset -= 256;
+			target = (address + *length + offset) & 0xFFFF;
+			sprintf(operand,"%04x",target);
+		}
+		const char *label = (target >= 0) ? DISSymbol(target) : NULL;
+		strcpy(buffer+n,(label != NULL) ? label : operand);
+		n += strlen(buffer+n);
+		m += 2;
+	}
+	buffer[n] = '\0';
+	strncpy(text,buffer,DIS_TEXT_SIZE);text[DIS_TEXT_SIZE] = '\0';
+}
+
+const char *DISDisassemble(WORD16 address,int *length) {
+	static char ioText[DIS_TEXT_SIZE+1];
+	int physical = CPUMapAddress(address);
+	if (physical < 0) { 															// I/O, nothing to cache.
+		_DISDecode(address,ioText,length);
+		return ioText;
+	}
+	int endPhysical = CPUMapAddress((address+2) & 0xFFFF); 						// Operands may be in another page
+	LONG32 version = disPageVersion[physical >> 13] + (endPhysical < 0 ? 0 : disPageVersion[endPhysical >> 13]);
+	LONG64 mapKey = _DISMapKey();
+	_CachedLine *c = &lineCache[(physical ^ (physical >> 8)) & (DIS_LINE_CACHE-1)];
+	if (c->physical != physical || c->address != address || c->version != version || c->mapKey != mapKey) {
+		_DISDecode(address,c->text,&c->length);
+		c->physical = physical;c->address = address;c->version = version;c->mapKey = mapKey;
+	}
+	*length = c->length;
+	return c->text;
+}
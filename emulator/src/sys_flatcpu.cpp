@@ -0,0 +1,134 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_flatcpu.cpp
+//		Purpose:	The generated 65C02 core on a flat 64k of RAM, with none of the F256 hardware, for running
+//					conformance tests and benchmarks at full speed. Each thread has its own registers and memory, so
+//					it doesn't disturb the emulated machine and several can run at once ; this file is also all
+//					that's needed to use the core elsewhere.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "sys_processor.h"
+#include "sys_flatcpu.h"
+
+#define CORE_LOCAL 	thread_local 													// One core a thread
+
+static CORE_LOCAL BYTE8 a,x,y,s;													// 6502 A,X,Y and Stack registers
+static CORE_LOCAL BYTE8 carryFlag,interruptDisableFlag,breakFlag,					// Values representing status reg
+			 decimalFlag,overflowFlag,sValue,zValue;
+static CORE_LOCAL WORD16 pc;														// Program Counter.
+static CORE_LOCAL LONG32 cycles;													// Cycle Count.
+static CORE_LOCAL BYTE8 memory[0x10000];
+static CORE_LOCAL struct FCPAccess *accessLog; 										// Logged accesses, FCPStepLogged()
+static CORE_LOCAL int accessCount,accessMax;
+
+// *******************************************************************************************************************************
+//						The buses, plain or logging every access, and the core as a template on them
+// *******************************************************************************************************************************
+
+struct FlatBus {
+	static inline BYTE8 ReadByte(WORD16 address) { return memory[address]; }
+	static inline void WriteByte(WORD16 address,BYTE8 data) { memory[address] = data; }
+};
+
+struct LoggingBus {
+	static inline void Log(WORD16 address,BYTE8 data,BYTE8 isWrite) {
+		if (accessCount < accessMax) {
+			accessLog[accessCount].address = address;
+			accessLog[accessCount].data = data;accessLog[accessCount].isWrite = isWrite;
+		}
+		accessCount++;
+	}
+	static inline BYTE8 ReadByte(WORD16 address) { Log(address,memory[address],0);return memory[address]; }
+	static inline void WriteByte(WORD16 address,BYTE8 data) { Log(address,data,1);memory[address] = data; }
+};
+
+#define Read(a) 	BUS::ReadByte(a)
+#define Write(a,d)	BUS::WriteByte(a,d)
+#define ReadWord(a) (Read(a) | ((Read((a)+1) << 8)))
+#define Cycles(n) 	cycles += (n)
+#define Fetch() 	BUS::ReadByte(pc++)
+#define FetchWord()	{ temp16 = Fetch();temp16 |= (Fetch() << 8); }
+
+#include "processor/__6502support.h"
+
+template <class BUS> static inline void _FCPInstruction(void) {
+	switch(Fetch()) {
+		#include "processor/__6502opcodes.h"
+	}
+}
+
+// *******************************************************************************************************************************
+//									Reset, clearing memory, and the memory itself
+// *******************************************************************************************************************************
+
+void FCPReset(void) {
+	memset(memory,0,sizeof(memory));
+	a = x = y = 0;s = 0xFF;
+	carryFlag = breakFlag = decimalFlag = overflowFlag = sValue = zValue = 0;
+	cycles = 0;
+	resetProcessor<FlatBus>();
+}
+
+BYTE8 *FCPMemory(void) {
+	return memory;
+}
+
+// *******************************************************************************************************************************
+//												Get and set the registers
+// *******************************************************************************************************************************
+
+void FCPGetState(struct FCPState *st) {
+	st->pc = pc;st->a = a;st->x = x;st->y = y;st->s = s;
+	st->p = constructFlagRegister() | 0x10;
+}
+
+void FCPSetState(struct FCPState *st) {
+	pc = st->pc;a = st->a;x = st->x;y = st->y;s = st->s;
+	explodeFlagRegister(st->p);
+}
+
+// *******************************************************************************************************************************
+//		Run one instruction, returning its cycles, optionally logging the bus accesses ; or run for a number of cycles,
+//		or to an address.
+// *******************************************************************************************************************************
+
+int FCPStep(void) {
+	cycles = 0;
+	_FCPInstruction<FlatBus>();
+	return cycles;
+}
+
+int FCPStepLogged(struct FCPAccess *log,int maxAccesses,int *count) {
+	accessLog = log;accessMax = maxAccesses;accessCount = 0;
+	cycles = 0;
+	_FCPInstruction<LoggingBus>();
+	*count = accessCount; 															// May be more than were logged
+	return cycles;
+}
+
+LONG64 FCPRun(LONG64 cycleCount,WORD16 stopAddress) { 								// Returns cycles actually run
+	LONG64 total = 0;
+	while (total < cycleCount && pc != stopAddress) {
+		LONG64 chunk = cycleCount - total; 											// cycles is only 32 bits
+		LONG32 limit = (chunk > 0x10000000) ? 0x10000000 : (LONG32)chunk;
+		cycles = 0;
+		while (cycles < limit && pc != stopAddress) _FCPInstruction<FlatBus>();
+		total += cycles;
+	}
+	return total;
+}
+
+void FCPInterrupt(int isNMI) {
+	if (isNMI) {
+		nmiCode<FlatBus>();
+	} else {
+		irqCode<FlatBus>();
+	}
+}
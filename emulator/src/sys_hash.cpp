@@ -0,0 +1,125 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_hash.cpp
+//		Purpose:	64 bit hash of everything that makes up the display - Vicky, sprite and colour registers, text, fonts,
+//					graphics LUTs, and the RAM bitmaps, tiles and sprites come from - so a changed frame can be spotted
+//					without drawing it. Parts are only hashed again when they have been written.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include "sys_processor.h"
+#include "hardware.h"
+#include "sys_disasm.h"
+#include "sys_text.h"
+#include "sys_hash.h"
+
+static LONG32 paletteVersion = 1; 													// Bumped on writes to I/O page 1
+static LONG32 paletteHashVersion = 0;
+static LONG64 paletteHash;
+static LONG32 pageHashVersion[HSH_GRAPHICS_PAGES]; 									// RAM page hashes, and the versions
+static LONG64 pageHash[HSH_GRAPHICS_PAGES];
+static int pagesValid = 0;
+static FILE *hashFile = NULL; 														// hashes@<file>
+static int frameCount = 0;
+static LONG64 lastText,lastDisplay;
+
+// *******************************************************************************************************************************
+//									Fonts and LUTs written, or everything written behind our back
+// *******************************************************************************************************************************
+
+void HSHPaletteWritten(void) {
+	paletteVersion++;
+}
+
+void HSHInvalidate(void) {
+	paletteVersion++;
+	pagesValid = 0;
+	TXTInvalidate();
+}
+
+// *******************************************************************************************************************************
+//													Hash a block of memory
+// *******************************************************************************************************************************
+
+static LONG64 _HSHIO(LONG64 hash,int page,int from,int to) {
+	for (int a = from;a < to;a++) hash = (hash ^ IOReadMemory(page,a)) * TXT_FNV_PRIME;
+	return hash;
+}
+
+static LONG64 _HSHRAMPage(int page) {
+	if (pagesValid == 0) { 															// Versions can't be trusted
+		pagesValid = -1;
+		DISWantPageVersions(); 														// Kept as the CPU runs from now on
+		for (int i = 0;i < HSH_GRAPHICS_PAGES;i++) pageHashVersion[i] = disPageVersion[i]-1;
+	}
+	if (pageHashVersion[page] != disPageVersion[page]) {
+		pageHashVersion[page] = disPageVersion[page];
+		BYTE8 *memory = CPUAccessMemory() + (page << 13);
+		LONG64 hash = TXT_FNV_BASIS;
+		for (int i = 0;i < 8192;i++) hash = (hash ^ memory[i]) * TXT_FNV_PRIME;
+		pageHash[page] = hash;
+	}
+	return pageHash[page];
+}
+
+// *******************************************************************************************************************************
+//
+//		The display hash. The registers are always hashed (there are not many of them) ; the text is only included if
+//		text is on, and the first 256k of RAM only if a bitmap, tile map or sprite layer is.
+//
+// *******************************************************************************************************************************
+
+LONG64 HSHDisplayHash(void) {
+	int ctrl = IOReadMemory(0,0xD000);
+	LONG64 hash = TXT_FNV_BASIS;
+	hash = _HSHIO(hash,0,0xD000,0xD300); 											// Vicky, bitmap and tile map registers
+	hash = _HSHIO(hash,0,0xD800,0xD880); 											// Text colour LUTs
+	hash = _HSHIO(hash,0,0xD900,0xDB00); 											// Sprites
+	if (paletteHashVersion != paletteVersion) { 									// Font and graphics LUTs
+		paletteHashVersion = paletteVersion;
+		paletteHash = _HSHIO(TXT_FNV_BASIS,1,0xC000,0xE000);
+	}
+	hash = (hash ^ paletteHash) * TXT_FNV_PRIME;
+	if (ctrl & 1) hash = (hash ^ TXTHash()) * TXT_FNV_PRIME;
+	if ((ctrl & 0x04) != 0 && (ctrl & 0x38) != 0) {
+		for (int p = 0;p < HSH_GRAPHICS_PAGES;p++) hash = (hash ^ _HSHRAMPage(p)) * TXT_FNV_PRIME;
+	}
+	return hash;
+}
+
+// *******************************************************************************************************************************
+//
+//		hashes@<file>. At the end of each frame, writes the frame number with the text and display hashes, if either
+//		has changed since the last line, so the frames not in it were the same as the one before.
+//
+// *******************************************************************************************************************************
+
+int HSHOpen(const char *fileName) {
+	if (hashFile != NULL) return -1; 												// Already open (e.g. after reset)
+	hashFile = fopen(fileName,"w");
+	if (hashFile == NULL) return 0;
+	fprintf(hashFile,"frame,text,display\n");
+	frameCount = 0;
+	lastText = lastDisplay = 0;
+	return -1;
+}
+
+void HSHEndFrame(void) {
+	if (hashFile == NULL) return;
+	frameCount++;
+	LONG64 text = TXTHash(),display = HSHDisplayHash();
+	if (text != lastText || display != lastDisplay) {
+		fprintf(hashFile,"%d,%016llx,%016llx\n",frameCount,text,display);
+		lastText = text;lastDisplay = display;
+	}
+}
+
+void HSHClose(void) {
+	if (hashFile != NULL) fclose(hashFile);
+	hashFile = NULL;
+}
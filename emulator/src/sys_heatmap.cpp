@@ -0,0 +1,160 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_heatmap.cpp
+//		Purpose:	Physical memory read/write/execute heatmap, and MMU thrash detection.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "sys_heatmap.h"
+
+LONG64 hmpCount[3][HMP_BLOCKS]; 													// Counts for each 256 byte block
+
+static int remapFrame,remapLast,remapPeak; 											// MMU writes this frame, last, most
+static int slotFrame[8],slotActivity[8]; 											// LUT edits per slot, decaying activity
+static int exportOnExit = 0;
+
+// *******************************************************************************************************************************
+//														Clear counters
+// *******************************************************************************************************************************
+
+void HMPReset(void) {
+	memset(hmpCount,0,sizeof(hmpCount));
+	remapFrame = remapLast = remapPeak = 0;
+	for (int i = 0;i < 8;i++) slotFrame[i] = slotActivity[i] = 0;
+}
+
+// *******************************************************************************************************************************
+//						MMU write, slot is the LUT entry being edited, or -1 for the MMU control
+// *******************************************************************************************************************************
+
+void HMPRemap(int slot) {
+	remapFrame++;
+	if (slot >= 0) slotFrame[slot & 7]++;
+}
+
+void HMPEndFrame(void) {
+	remapLast = remapFrame;remapFrame = 0;
+	if (remapLast > remapPeak) remapPeak = remapLast;
+	for (int i = 0;i < 8;i++) {
+		slotActivity[i] = slotActivity[i] * 15 / 16 + slotFrame[i] * 16; 			// Fades over a second or so.
+		slotFrame[i] = 0;
+	}
+}
+
+int HMPSlotActivity(int slot) {
+	return slotActivity[slot & 7];
+}
+
+// *******************************************************************************************************************************
+//
+//									Export non-zero pages and 256 byte blocks as CSV
+//
+// *******************************************************************************************************************************
+
+static void _HMPBlockName(int block,char *buffer) {
+	if (block < HMP_RAM_BLOCKS) {
+		sprintf(buffer,"%05x",block << 8);
+	} else {
+		block -= HMP_RAM_BLOCKS;
+		sprintf(buffer,"io%d:%04x",block >> 5,0xC000+((block & 0x1F) << 8));
+	}
+}
+
+void HMPEnableExport(void) {
+	exportOnExit = -1;
+}
+
+int HMPIsCounting(void) { 															// Only counted if 'heatmap', costs time
+	return exportOnExit;
+}
+
+void HMPExportOnExit(void) {
+	if (exportOnExit) HMPExport();
+}
+
+void HMPExport(void) {
+	char name[16];
+	FILE *f = fopen(HMP_EXPORT_FILE,"w");
+	if (f == NULL) return;
+	fprintf(f,"kind,address,reads,writes,executes\n");
+	for (int p = 0;p < HMP_PAGES+4;p++) { 											// Pages, then I/O pages
+		LONG64 t[3] = { 0,0,0 };
+		for (int b = p*32;b < p*32+32;b++) {
+			for (int i = 0;i < 3;i++) t[i] += hmpCount[i][b];
+		}
+		_HMPBlockName(p*32,name);
+		if (t[0]+t[1]+t[2] != 0) fprintf(f,"page,%s,%llu,%llu,%llu\n",name,t[0],t[1],t[2]);
+	}
+	for (int b = 0;b < HMP_BLOCKS;b++) {
+		if (hmpCount[0][b]+hmpCount[1][b]+hmpCount[2][b] != 0) {
+			_HMPBlockName(b,name);
+			fprintf(f,"block,%s,%llu,%llu,%llu\n",name,hmpCount[0][b],hmpCount[1][b],hmpCount[2][b]);
+		}
+	}
+	fprintf(f,"mmu,peak_writes_per_frame,%d,,\n",remapPeak);
+	fclose(f);
+	printf("Heatmap written to %s\n",HMP_EXPORT_FILE);
+}
+
+// *******************************************************************************************************************************
+//
+//		Draw the 128 physical pages as a 16x8 grid, the I/O pages on a ninth row. Red is writes, green reads, blue execution,
+//		each on a log scale against the busiest page.
+//
+// *******************************************************************************************************************************
+
+static int _HMPLog2(LONG64 n) {
+	int r = 0;
+	while (n != 0) { r++;n >>= 1; }
+	return r;
+}
+
+void HMPRender(int x,int y,int w,int h) {
+	static LONG64 total[3][HMP_PAGES+4];
+	int maxLog[3] = { 1,1,1 };
+	for (int p = 0;p < HMP_PAGES+4;p++) {
+		for (int i = 0;i < 3;i++) {
+			LONG64 t = 0;
+			for (int b = p*32;b < p*32+32;b++) t += hmpCount[i][b];
+			total[i][p] = t;
+			if (_HMPLog2(t) > maxLog[i]) maxLog[i] = _HMPLog2(t);
+		}
+	}
+	static int lastColour[HMP_PAGES+4],lastGeneration = -1; 						// Only draw cells that change
+	if (lastGeneration != GFXGeneration()) {
+		lastGeneration = GFXGeneration();
+		for (int p = 0;p < HMP_PAGES+4;p++) lastColour[p] = -1;
+	}
+	int cw = w / 16,ch = h / 9;
+	for (int p = 0;p < HMP_PAGES+4;p++) {
+		int colour = 0;
+		for (int i = 0;i < 3;i++) {
+			int level = (total[i][p] == 0) ? 0 : 3+_HMPLog2(total[i][p]) * 12 / maxLog[i];
+			if (level > 15) level = 15;
+			colour |= level << (i == 0 ? 4 : (i == 1 ? 8 : 0)); 					// Read green, Write red, Execute blue
+		}
+		if (colour == lastColour[p]) continue;
+		lastColour[p] = colour;
+		SDL_Rect rc;
+		int cell = (p < HMP_PAGES) ? p : p - HMP_PAGES + 8 * 16; 					// I/O pages start the ninth row
+		rc.x = x + (cell % 16) * cw;rc.y = y + (cell / 16) * ch;rc.w = cw-1;rc.h = ch-1;
+		GFXRectangle(&rc,(colour == 0) ? 0x222 : colour);
+	}
+}
+
+// *******************************************************************************************************************************
+//								Status text for the panel, returns non-zero if MMU is thrashing
+// *******************************************************************************************************************************
+
+int HMPRenderStatus(char *buffer) {
+	sprintf(buffer,"MMU %d/frame peak %d",remapLast,remapPeak);
+	return remapLast >= HMP_THRASH;
+}
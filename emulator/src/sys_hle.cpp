@@ -0,0 +1,348 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_hle.cpp
+//		Purpose:	High level emulation. Native versions of the monitor's hot routines (kernel/newmonitor.asm), hooked by
+//					physical address from the listing's labels. Each does the same bus accesses the 6502 code would
+//					leave behind, charges the cycles it would take, and returns as RTS does. Stack below the stack
+//					pointer, which is dead, is not written.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "sys_processor.h"
+#include "sys_disasm.h"
+#include "sys_hle.h"
+
+BYTE8 hleOffsets[0x2000];
+
+// *******************************************************************************************************************************
+//									The monitor's workspace and constants, as newmonitor.asm
+// *******************************************************************************************************************************
+
+#define MON_ZTEMP0 			(0xFC)
+#define MON_IO_PAGE 		(0x01)
+#define MON_XPOS 			(0x203)
+#define MON_YPOS 			(0x204)
+#define MON_TEXT_COLOUR 	(0x205)
+#define MON_CURRENT_PAGE 	(0x206)
+#define MON_WIDTH 			(80)
+#define MON_HEIGHT 			(60)
+#define MON_SCREEN 			(0xC000) 												// Text (I/O page 2) and colour (3)
+#define MON_SCREEN_END 		(0xD300) 												// Where the loops stop
+#define MON_BOTTOM_LINE 	(0xD270)
+
+#define Read(a) 	CPUReadMemory(a)
+#define Write(a,d) 	CPUWriteMemory(a,d)
+#define Charge(n) 	hleCycles += (n)												// Cycles the 6502 code takes
+
+static int hleCycles;
+
+// *******************************************************************************************************************************
+//											Flags, as the 6502 sets them
+// *******************************************************************************************************************************
+
+static void _HLEFlagsNZ(struct HLERegisters *r,BYTE8 n) {
+	r->p = (r->p & 0x7D) | (n & 0x80) | ((n == 0) ? 0x02 : 0);
+}
+
+static void _HLECompare(struct HLERegisters *r,BYTE8 reg,BYTE8 n) {
+	_HLEFlagsNZ(r,reg-n);
+	r->p = (r->p & 0xFE) | ((reg >= n) ? 1 : 0);
+}
+
+static BYTE8 _HLEAdd(struct HLERegisters *r,BYTE8 n1,BYTE8 n2) { 					// ADC, not decimal
+	int result = n1 + n2 + (r->p & 1);
+	r->p &= 0xBE;
+	if ((n1 & 0x80) == (n2 & 0x80) && (n1 & 0x80) != (result & 0x80)) r->p |= 0x40;
+	if (result & 0x100) r->p |= 0x01;
+	_HLEFlagsNZ(r,result);
+	return result & 0xFF;
+}
+
+// *******************************************************************************************************************************
+//
+//		The routines, following the assembler. Each charges its cycles including the RTS, the caller charges the JSR.
+//
+// *******************************************************************************************************************************
+
+static void _HLESelectPage(struct HLERegisters *r,int page) { 					// SelectPage0-3
+	BYTE8 io = Read(MON_IO_PAGE);
+	if (page != 3) io &= 0xFC;
+	io |= page;
+	Write(MON_IO_PAGE,io);
+	Write(MON_CURRENT_PAGE,io);
+	_HLEFlagsNZ(r,r->a);
+	Charge((page == 0) ? 25 : ((page == 3) ? 27 : 29));
+}
+
+static void _HLEUpdateCursor(struct HLERegisters *r) {
+	Write(0xD014,Read(MON_XPOS));
+	Write(0xD016,Read(MON_YPOS));
+	_HLEFlagsNZ(r,r->a);
+	Charge(29);
+}
+
+static WORD16 _HLESetCharPos(struct HLERegisters *r) { 							// SetZTemp0CharPos, returns zTemp0
+	BYTE8 yPos = Read(MON_YPOS);
+	BYTE8 lo = yPos,hi = 0;
+	Charge(22);
+	for (int x = 6;x > 0;x--) { 													// x 80
+		hi = (hi << 1) | (lo >> 7);
+		lo = lo << 1;
+		Charge(16);
+		if (x == 5) {
+			Charge(14);
+			if (lo + yPos > 0xFF) { hi++;Charge(5); }
+			lo += yPos;
+		}
+	}
+	r->p &= 0xFE;
+	lo = _HLEAdd(r,lo,Read(MON_XPOS));
+	hi = _HLEAdd(r,hi,0xC0);
+	Write(MON_ZTEMP0,lo);
+	Write(MON_ZTEMP0+1,hi);
+	_HLEFlagsNZ(r,r->a);
+	Charge(20+16);
+	return lo | (hi << 8);
+}
+
+static void _HLEScrollBank(struct HLERegisters *r) { 							// _ScrollBank, one line up
+	for (int address = MON_SCREEN;address < MON_SCREEN_END;address++) {
+		Write(address,Read(address+MON_WIDTH));
+	}
+	Write(MON_ZTEMP0,MON_SCREEN_END & 0xFF);
+	Write(MON_ZTEMP0+1,MON_SCREEN_END >> 8);
+	r->a = MON_SCREEN_END >> 8;r->y = MON_WIDTH;
+	_HLECompare(r,r->a,MON_SCREEN_END >> 8);
+	Charge(12 + (MON_SCREEN_END-MON_SCREEN) * 19 + ((MON_SCREEN_END-MON_SCREEN) >> 8) * 12 + 6);
+}
+
+static void _HLEWriteBottomLine(struct HLERegisters *r,BYTE8 data) { 			// _WriteBottomLine
+	for (int i = MON_WIDTH-1;i >= 0;i--) Write(MON_BOTTOM_LINE+i,data);
+	Write(MON_ZTEMP0,MON_BOTTOM_LINE & 0xFF);
+	Write(MON_ZTEMP0+1,MON_BOTTOM_LINE >> 8);
+	r->a = data;r->y = 0xFF;
+	_HLEFlagsNZ(r,r->y);
+	Charge(19 + MON_WIDTH * 10 + 6);
+}
+
+static void _HLEScrollScreenUp(struct HLERegisters *r) {
+	BYTE8 y = r->y;
+	Charge(2+3+6);_HLESelectPage(r,3);
+	Charge(6);_HLEScrollBank(r);
+	Charge(4+6);_HLEWriteBottomLine(r,Read(MON_TEXT_COLOUR));
+	Charge(6);_HLESelectPage(r,2);
+	Charge(6);_HLEScrollBank(r);
+	Charge(2+6);_HLEWriteBottomLine(r,0x20);
+	r->a = r->y = y;
+	_HLEFlagsNZ(r,y);
+	Charge(4+2+6);
+}
+
+static void _HLEScreenFill(struct HLERegisters *r) { 							// _ScreenFill, then on into HomeCursor
+	for (int address = MON_SCREEN;address < MON_SCREEN_END;address++) Write(address,r->a);
+	Write(MON_ZTEMP0,MON_SCREEN_END & 0xFF);
+	Write(MON_ZTEMP0+1,MON_SCREEN_END >> 8);
+	r->x = MON_SCREEN_END >> 8;r->y = 0;
+	_HLECompare(r,r->x,MON_SCREEN_END >> 8);
+	Charge(19 + (MON_SCREEN_END-MON_SCREEN) * 10 + ((MON_SCREEN_END-MON_SCREEN) >> 8) * 12);
+	Charge(6);_HLESelectPage(r,0);
+	r->a = 0;
+	Write(MON_XPOS,0);
+	Write(MON_YPOS,0);
+	Charge(2+4+4+6);_HLEUpdateCursor(r);
+	Charge(6);
+}
+
+static void _HLEPrintCharacter(struct HLERegisters *r) {
+	BYTE8 a = r->a,x = r->x,y = r->y;
+	BYTE8 io = Read(MON_IO_PAGE);
+	r->x = io;
+	Charge(3+3+3+3+3+6);_HLESelectPage(r,2);
+	Charge(3);
+	if (a == 8) { 																	// Backspace
+		Charge(4);_HLECompare(r,a,8);
+		BYTE8 xPos = Read(MON_XPOS);
+		Charge(4+2);
+		if (xPos != 0) {
+			Write(MON_XPOS,xPos-1);
+			Charge(6+6);
+			WORD16 p = _HLESetCharPos(r);
+			Write(p,' ');
+			Charge(2+6+2);
+		}
+	} else if (a == 9) { 															// Tab, spaces to a multiple of 8
+		Charge(4+4);_HLECompare(r,a,9);
+		BYTE8 n;
+		do {
+			r->a = ' ';
+			Charge(2+6);_HLEPrintCharacter(r);
+			r->a = n = Read(MON_XPOS) & 7;
+			_HLEFlagsNZ(r,n);
+			Charge(4+2+2);
+		} while (n != 0);
+		Charge(2);
+	} else if (a == 13) { 															// Return, spaces to the end of the line
+		Charge(4+4+4);_HLECompare(r,a,13);
+		BYTE8 n;
+		do {
+			r->a = ' ';
+			Charge(2+6);_HLEPrintCharacter(r);
+			r->a = n = Read(MON_XPOS);
+			_HLEFlagsNZ(r,n);
+			Charge(4+2);
+		} while (n != 0);
+		Charge(2);
+	} else {
+		Charge(4+4+4);_HLECompare(r,a,13);
+		Charge(6);WORD16 p = _HLESetCharPos(r);
+		Write(p,a);
+		Charge(6);
+		Charge(6);_HLESelectPage(r,3);
+		Write(p,Read(MON_TEXT_COLOUR));
+		Charge(4+6);
+		Charge(6);_HLESelectPage(r,2);
+		BYTE8 xPos = Read(MON_XPOS)+1;
+		Write(MON_XPOS,xPos);
+		Charge(6+4+2+2);_HLECompare(r,xPos,MON_WIDTH);
+		if (xPos == MON_WIDTH) { 													// Next line
+			Write(MON_XPOS,0);
+			BYTE8 yPos = Read(MON_YPOS)+1;
+			Write(MON_YPOS,yPos);
+			Charge(4+6+4+2+2);_HLECompare(r,yPos,MON_HEIGHT);
+			if (yPos == MON_HEIGHT) { 												// Off the bottom
+				Write(MON_YPOS,yPos-1);
+				Charge(6+6);_HLEScrollScreenUp(r);
+			}
+		}
+	}
+	Charge(6);_HLESelectPage(r,0);
+	Charge(6);_HLEUpdateCursor(r);
+	Write(MON_IO_PAGE,io);
+	r->a = a;r->x = x;r->y = y;
+	_HLEFlagsNZ(r,a);
+	Charge(4+4+3+4+4+4+6);
+}
+
+// *******************************************************************************************************************************
+//
+//		The hooks. The signature is the routine's first bytes, so a different monitor isn't hooked by mistake. The
+//		native version returns zero if it can't do it (decimal mode would change ADC), and the 6502 runs it.
+//
+// *******************************************************************************************************************************
+
+static int _HLEHookPrintCharacter(struct HLERegisters *r) {
+	if (r->p & 0x08) return 0;
+	_HLEPrintCharacter(r);
+	return -1;
+}
+
+static int _HLEHookScrollScreenUp(struct HLERegisters *r) {
+	_HLEScrollScreenUp(r);
+	return -1;
+}
+
+static int _HLEHookScreenFill(struct HLERegisters *r) {
+	_HLEScreenFill(r);
+	return -1;
+}
+
+struct _HLEHook {
+	const char *name; 																// Label in the listing
+	int 	length;
+	BYTE8 	signature[12];
+	int 	(*native)(struct HLERegisters *r);
+};
+
+static const struct _HLEHook hooks[] = {
+	{ "PrintCharacter",6,{ 0x48,0xDA,0x5A,0xA6,0x01,0xDA },_HLEHookPrintCharacter },
+	{ "ScrollScreenUp",2,{ 0x98,0x48 },_HLEHookScrollScreenUp },
+	{ "_ScreenFill",9,{ 0x48,0xA9,0xC0,0x85,0xFD,0xA9,0x00,0x85,0xFC },_HLEHookScreenFill }
+};
+
+#define HLE_HOOKS 	((int)(sizeof(hooks)/sizeof(hooks[0])))
+
+static struct { int physical,hook; } installed[HLE_MAX_INSTALLED];
+static int installedCount,isChecking,reported;
+static LONG64 calls[HLE_HOOKS],checked[HLE_HOOKS],failed[HLE_HOOKS];
+
+// *******************************************************************************************************************************
+//						Hook the routines found in the listing(s) loaded, returns how many are hooked
+// *******************************************************************************************************************************
+
+int HLEInstall(int checking) {
+	isChecking = checking;
+	installedCount = 0;
+	memset(hleOffsets,0,sizeof(hleOffsets));
+	BYTE8 *memory = CPUAccessMemory();
+	for (int h = 0;h < HLE_HOOKS;h++) {
+		int physical[HLE_MAX_INSTALLED];
+		int n = DISFindSymbol(hooks[h].name,physical,HLE_MAX_INSTALLED);
+		for (int i = 0;i < n && installedCount < HLE_MAX_INSTALLED;i++) {
+			if (physical[i] + hooks[h].length > MEMSIZE) continue;
+			if (memcmp(memory+physical[i],hooks[h].signature,hooks[h].length) != 0) continue;
+			installed[installedCount].physical = physical[i];
+			installed[installedCount++].hook = h;
+			hleOffsets[physical[i] & 0x1FFF] = 1;
+		}
+	}
+	printf("HLE : %d routine entries hooked%s\n",installedCount,
+					(installedCount == 0) ? " (the monitor's labels are needed, see symbols@)" : "");
+	return installedCount;
+}
+
+// *******************************************************************************************************************************
+//											The hook at a physical address, or -1
+// *******************************************************************************************************************************
+
+int HLEFind(int physical) {
+	for (int i = 0;i < installedCount;i++) {
+		if (installed[i].physical == physical) return installed[i].hook;
+	}
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//			Run a hook, returning from the routine as RTS would. Returns the cycles taken, -1 if the 6502 must do it
+// *******************************************************************************************************************************
+
+int HLECall(int hook,struct HLERegisters *r) {
+	hleCycles = 0;
+	if (hooks[hook].native(r) == 0) return -1;
+	r->pc = (Read(0x100 | ((r->s+1) & 0xFF)) | (Read(0x100 | ((r->s+2) & 0xFF)) << 8)) + 1;
+	r->s += 2;
+	calls[hook]++;
+	return hleCycles;
+}
+
+// *******************************************************************************************************************************
+//							hlecheck result, differences is empty if the 6502 version matched
+// *******************************************************************************************************************************
+
+void HLECheckResult(int hook,const char *differences) {
+	checked[hook]++;
+	if (*differences == '\0') return;
+	failed[hook]++;
+	if (reported++ < HLE_MAX_REPORT) printf("HLE : %s differs from the 6502 code (native/6502) :%s\n",hooks[hook].name,differences);
+}
+
+// *******************************************************************************************************************************
+//										Report on exit, returns the number of failed checks
+// *******************************************************************************************************************************
+
+int HLEReport(void) {
+	LONG64 totalFailed = 0;
+	for (int h = 0;h < HLE_HOOKS;h++) {
+		if (calls[h] == 0) continue;
+		printf("HLE : %-16s %llu calls",hooks[h].name,calls[h]);
+		if (isChecking) printf(", %llu of %llu differed from the 6502 code",failed[h],checked[h]);
+		printf("\n");
+		totalFailed += failed[h];
+	}
+	return (totalFailed != 0) ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_latency.cpp
+//		Purpose:	Keyboard input to guest latency measurement. Each PS/2 byte is followed from the SDL event, through
+//					the keyboard queue, the FIFO and the interrupt, to the guest reading $D642, recording host time and
+//					cycles at each stage. Both queues are first in first out, so bytes are matched up by counting.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "hardware.h"
+#include "sys_latency.h"
+
+struct _LatencyRecord {
+	int 	code; 																	// PS/2 byte
+	int 	reached; 																// Bit set for each stage reached
+	int 	dropped; 																// Lost when the FIFO was full
+	LONG64 	time[LAT_STAGES]; 														// Host performance counter
+	LONG64 	cycles[LAT_STAGES]; 													// CPU cycles
+};
+
+static struct _LatencyRecord records[LAT_RECORDS];
+static int isEnabled = 0,isSpeculating = 0;
+static LONG32 queueSeq,fifoSeq,readSeq; 											// Next byte queued, to FIFO, read
+static int queueDropped,fifoDropped; 												// Bytes lost at each queue
+static LONG64 hostTime = 0; 														// Time of the SDL event being handled
+
+static double testRate = 0.0; 														// Keys per second, 0 if not testing
+static double testCredit; 															// Keys owed
+static int testKeys,testWait,testSettle; 											// Keys typed, frames to wait
+
+#define RECORD(n) 	(&records[(n) & (LAT_RECORDS-1)])
+
+// *******************************************************************************************************************************
+//														Start measuring
+// *******************************************************************************************************************************
+
+void LATEnable(void) {
+	if (isEnabled) return;
+	isEnabled = -1;
+	queueSeq = fifoSeq = readSeq = 0;
+	queueDropped = fifoDropped = 0;
+}
+
+void LATSpeculating(int isOn) { 													// Run-ahead frames don't count
+	isSpeculating = isOn;
+}
+
+static void _LATStage(struct _LatencyRecord *r,int stage) {
+	r->reached |= (1 << stage);
+	r->time[stage] = SDL_GetPerformanceCounter();
+	r->cycles[stage] = CPUGetCycleCount();
+}
+
+// *******************************************************************************************************************************
+//
+//		An SDL key event is being handled ; the bytes it queues are timed from when SDL stamped it, which is in ms.
+//		Called with zero when it has been.
+//
+// *******************************************************************************************************************************
+
+void LATHostEvent(LONG32 timestamp) {
+	hostTime = 0; 																	// 0 when finished
+	if (isEnabled == 0 || timestamp == 0) return;
+	LONG64 waited = SDL_GetTicks() - timestamp;
+	hostTime = SDL_GetPerformanceCounter() - waited * SDL_GetPerformanceFrequency() / 1000;
+}
+
+// *******************************************************************************************************************************
+//												Stages, called by the hardware
+// *******************************************************************************************************************************
+
+void LATQueued(int code,int isAccepted) {
+	if (isEnabled == 0 || isSpeculating) return;
+	if (!isAccepted) { queueDropped++;return; }
+	struct _LatencyRecord *r = RECORD(queueSeq++);
+	r->code = code;r->reached = 0;r->dropped = 0;
+	_LATStage(r,LAT_QUEUED);
+	r->time[LAT_HOST] = (hostTime != 0) ? hostTime : r->time[LAT_QUEUED]; 			// Typed by the test, no SDL event
+	r->cycles[LAT_HOST] = r->cycles[LAT_QUEUED];
+	r->reached |= (1 << LAT_HOST);
+}
+
+void LATFifo(int isAccepted) {
+	if (isEnabled == 0 || isSpeculating || fifoSeq == queueSeq) return;
+	struct _LatencyRecord *r = RECORD(fifoSeq++);
+	if (isAccepted) {
+		_LATStage(r,LAT_FIFO);
+	} else {
+		r->dropped = -1;fifoDropped++;
+	}
+}
+
+void LATInterrupt(void) {
+	if (isEnabled == 0 || isSpeculating || fifoSeq == 0) return;
+	struct _LatencyRecord *r = RECORD(fifoSeq-1);
+	if (r->dropped == 0 && (r->reached & (1 << LAT_IRQ)) == 0) _LATStage(r,LAT_IRQ);
+}
+
+void LATRead(void) {
+	if (isEnabled == 0 || isSpeculating) return;
+	while (readSeq != fifoSeq && RECORD(readSeq)->dropped) readSeq++; 			// Never reached the FIFO
+	if (readSeq != fifoSeq) _LATStage(RECORD(readSeq++),LAT_READ);
+}
+
+// *******************************************************************************************************************************
+//
+//		Scripted test. After the machine has booted, types bursts of keys at the given rate (in emulated time, so it is
+//		repeatable), each a press and a release, then exits once they have had time to be read.
+//
+// *******************************************************************************************************************************
+
+static const BYTE8 testCodes[] = { 0x1C,0x32,0x21,0x23,0x24,0x2B,0x34,0x33 }; 		// PS/2 set 2, a to h
+
+void LATStartTest(double keysPerSecond) {
+	LATEnable();
+	testRate = keysPerSecond;
+	testCredit = 0.0;testKeys = 0;
+	testWait = LAT_TEST_START;testSettle = 0;
+	printf("Latency test : %d bursts of %d keys at %.1f keys/second\n",LAT_TEST_BURSTS,LAT_TEST_KEYS,testRate);
+}
+
+void LATTestFrame(void) {
+	if (testRate <= 0.0 || isSpeculating) return;
+	if (testSettle > 0) { 															// Finished typing, waiting.
+		if (--testSettle == 0) { testRate = 0.0;CPUExit(); }
+		return;
+	}
+	if (testWait > 0) { testWait--;return; } 										// Booting, or between bursts
+	testCredit += testRate / FRAME_RATE;
+	while (testCredit >= 1.0) {
+		testCredit -= 1.0;
+		int code = testCodes[testKeys % sizeof(testCodes)];
+		HWQueueKeyboardEvent(code);HWQueueKeyboardEvent(0xF0);HWQueueKeyboardEvent(code);
+		if (++testKeys % LAT_TEST_KEYS == 0) { 										// End of a burst
+			testCredit = 0.0;testWait = LAT_TEST_GAP;
+			if (testKeys == LAT_TEST_BURSTS * LAT_TEST_KEYS) testSettle = LAT_TEST_SETTLE;
+			break;
+		}
+	}
+}
+
+// *******************************************************************************************************************************
+//										Hardware reset, bytes in flight are lost
+// *******************************************************************************************************************************
+
+void LATReset(void) {
+	fifoSeq = readSeq = queueSeq;
+}
+
+// *******************************************************************************************************************************
+//
+//		Report the distribution of time between pairs of stages, and write every byte to a CSV file, times in us.
+//
+// *******************************************************************************************************************************
+
+static int _LATCompare(const void *a,const void *b) {
+	double d = *(const double *)a - *(const double *)b;
+	return (d < 0) ? -1 : (d > 0 ? 1 : 0);
+}
+
+static void _LATDistribution(const char *name,int from,int to) {
+	static double ms[LAT_RECORDS];
+	static LONG64 cycles[LAT_RECORDS];
+	int n = 0;
+	LONG32 first = (queueSeq > LAT_RECORDS) ? queueSeq - LAT_RECORDS : 0;
+	for (LONG32 i = first;i != queueSeq;i++) {
+		struct _LatencyRecord *r = RECORD(i);
+		if ((r->reached & (1 << from)) && (r->reached & (1 << to))) {
+			ms[n] = (double)(r->time[to] - r->time[from]) * 1000.0 / SDL_GetPerformanceFrequency();
+			cycles[n++] = r->cycles[to] - r->cycles[from];
+		}
+	}
+	if (n == 0) { printf("  %-14s      -\n",name);return; }
+	qsort(ms,n,sizeof(double),_LATCompare);
+	LONG64 total = 0;
+	for (int i = 0;i < n;i++) total += cycles[i];
+	printf("  %-14s %6d %8.2f %8.2f %8.2f %8.2f %8.2f %10llu\n",name,n,
+						ms[0],ms[n/2],ms[n*9/10],ms[n*99/100],ms[n-1],total/n);
+}
+
+void LATReport(void) {
+	if (isEnabled == 0) return;
+	printf("Keyboard latency, %u bytes, %d dropped by the queue, %d by the FIFO\n",queueSeq,queueDropped,fifoDropped);
+	printf("  %-14s %6s %8s %8s %8s %8s %8s %10s\n","ms","count","min","median","90%","99%","max","avg cycles");
+	_LATDistribution("event-queue",LAT_HOST,LAT_QUEUED);
+	_LATDistribution("queue-fifo",LAT_QUEUED,LAT_FIFO);
+	_LATDistribution("fifo-irq",LAT_FIFO,LAT_IRQ);
+	_LATDistribution("fifo-read",LAT_FIFO,LAT_READ);
+	_LATDistribution("event-read",LAT_HOST,LAT_READ);
+
+	FILE *f = fopen(LAT_CSV_FILE,"w");
+	if (f == NULL) return;
+	fprintf(f,"byte,code,dropped,host_us,queued_us,fifo_us,irq_us,read_us,host_cycles,queued_cycles,fifo_cycles,irq_cycles,read_cycles\n");
+	LONG32 first = (queueSeq > LAT_RECORDS) ? queueSeq - LAT_RECORDS : 0;
+	LONG64 origin = RECORD(first)->time[LAT_HOST];
+	for (LONG32 i = first;i != queueSeq;i++) {
+		struct _LatencyRecord *r = RECORD(i);
+		fprintf(f,"%u,%d,%d",i,r->code,r->dropped ? 1 : 0);
+		for (int s = 0;s < LAT_STAGES;s++) {
+			if (r->reached & (1 << s)) {
+				fprintf(f,",%.1f",(double)(r->time[s] - origin) * 1000000.0 / SDL_GetPerformanceFrequency());
+			} else {
+				fprintf(f,",");
+			}
+		}
+		for (int s = 0;s < LAT_STAGES;s++) {
+			if (r->reached & (1 << s)) fprintf(f,",%llu",r->cycles[s]); else fprintf(f,",");
+		}
+		fprintf(f,"\n");
+	}
+	fclose(f);
+	printf("Latency records written to %s\n",LAT_CSV_FILE);
+}
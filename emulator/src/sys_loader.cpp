@@ -0,0 +1,140 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_loader.cpp
+//		Purpose:	Image loader for <file>@<address>. Files are read whole and kept, keyed on name, time and size, so
+//					loading them again on reset is a copy. Files ending .pgx or .pgz are F256 executables, loaded to
+//					the physical addresses they give, which also give the start address.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/stat.h>
+#include "sys_processor.h"
+#include "sys_loader.h"
+
+struct _Image {
+	char 	*name;
+	time_t 	modified;
+	long 	size;
+	BYTE8 	*data;
+};
+
+static struct _Image cache[LDR_MAX_CACHED];
+static int cacheCount = 0;
+
+// *******************************************************************************************************************************
+//								Find a file in the cache, reading it if it is new or has changed
+// *******************************************************************************************************************************
+
+static struct _Image *_LDRRead(const char *fileName) {
+	struct stat info;
+	if (stat(fileName,&info) != 0) return NULL;
+	struct _Image *image = NULL;
+	for (int i = 0;i < cacheCount;i++) {
+		if (strcmp(cache[i].name,fileName) == 0) image = &cache[i];
+	}
+	if (image != NULL && image->modified == info.st_mtime && image->size == (long)info.st_size) return image;
+	if (image == NULL) { 															// New entry, reusing the last if full
+		image = &cache[(cacheCount < LDR_MAX_CACHED) ? cacheCount++ : LDR_MAX_CACHED-1];
+		free(image->name);
+		image->name = strdup(fileName);
+	}
+	free(image->data);
+	image->data = NULL;image->size = 0;image->modified = 0;
+	FILE *f = fopen(fileName,"rb");
+	if (f == NULL) return NULL;
+	image->data = (BYTE8 *)malloc(info.st_size+1);
+	image->size = fread(image->data,1,info.st_size,f);
+	image->modified = info.st_mtime;
+	fclose(f);
+	return image;
+}
+
+// *******************************************************************************************************************************
+//												Little endian value from a file
+// *******************************************************************************************************************************
+
+static int _LDRValue(BYTE8 *data,int bytes) {
+	int n = 0;
+	for (int i = bytes-1;i >= 0;i--) n = (n << 8) | data[i];
+	return n;
+}
+
+static int _LDRHasType(const char *fileName,const char *type) {
+	int n = strlen(fileName);
+	if (n < 4) return 0;
+	for (int i = 0;i < 4;i++) {
+		if (tolower(fileName[n-4+i]) != type[i]) return 0;
+	}
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		PGZ : 'Z' (3 byte fields) or 'z' (4 byte fields), then segments of address, length and data. A segment with no
+//		data gives the start address.
+//
+// *******************************************************************************************************************************
+
+static int _LDRLoadPGZ(struct _Image *image,BYTE8 *memory,int *startAddress) {
+	if (image->size < 1 || (image->data[0] != 'Z' && image->data[0] != 'z')) return LDR_BAD_FORMAT;
+	int fieldSize = (image->data[0] == 'Z') ? 3 : 4;
+	long pos = 1;
+	while (pos < image->size) {
+		if (pos + fieldSize * 2 > image->size) return LDR_BAD_FORMAT;
+		int address = _LDRValue(image->data+pos,fieldSize);
+		int length = _LDRValue(image->data+pos+fieldSize,fieldSize);
+		pos += fieldSize * 2;
+		if (length == 0) {
+			*startAddress = address;
+		} else {
+			if (length < 0 || length > image->size - pos) return LDR_BAD_FORMAT;
+			if (address < 0 || address > MEMSIZE - length) return LDR_BAD_FORMAT;
+			memcpy(memory+address,image->data+pos,length);
+			pos += length;
+		}
+	}
+	return LDR_OK;
+}
+
+// *******************************************************************************************************************************
+//								PGX : "PGX", $03 (65C02), 4 byte address, data loaded and run there
+// *******************************************************************************************************************************
+
+static int _LDRLoadPGX(struct _Image *image,BYTE8 *memory,int *startAddress) {
+	if (image->size < 8 || memcmp(image->data,"PGX\x03",4) != 0) return LDR_BAD_FORMAT;
+	int address = _LDRValue(image->data+4,4);
+	if (address < 0 || address > MEMSIZE - (image->size - 8)) return LDR_BAD_FORMAT;
+	memcpy(memory+address,image->data+8,image->size-8);
+	*startAddress = address;
+	return LDR_OK;
+}
+
+// *******************************************************************************************************************************
+//
+//		Load a file into physical memory. Raw files go at loadAddress, and are cut off at the end of memory. The start
+//		address is -1 unless the file gives one.
+//
+// *******************************************************************************************************************************
+
+int LDRLoad(const char *fileName,int loadAddress,int *startAddress) {
+	BYTE8 *memory = CPUAccessMemory();
+	*startAddress = -1;
+	struct _Image *image = _LDRRead(fileName);
+	if (image == NULL) return LDR_NO_FILE;
+	if (_LDRHasType(fileName,".pgz")) return _LDRLoadPGZ(image,memory,startAddress);
+	if (_LDRHasType(fileName,".pgx")) return _LDRLoadPGX(image,memory,startAddress);
+	if (loadAddress < MEMSIZE) {
+		long size = image->size;
+		if (loadAddress + size > MEMSIZE) size = MEMSIZE - loadAddress;
+		memcpy(memory+loadAddress,image->data,size);
+	}
+	return LDR_OK;
+}
@@ -16,14 +16,46 @@
 #include "sys_processor.h"
 #include "sys_debug_system.h"
 #include "hardware.h"
+#include "sys_profiler.h"
+#include "sys_trace.h"
+#include "sys_stats.h"
+#include "sys_heatmap.h"
+#include "sys_disasm.h"
+#include "sys_runahead.h"
+#include "sys_latency.h"
+#include "sys_script.h"
+#include "sys_text.h"
+#include "sys_hash.h"
+#include "sys_capture.h"
+#include "sys_vectors.h"
+#include "sys_flatcpu.h"
+#include "sys_hle.h"
+#include "sys_loader.h"
+#include "hw_sn76489.h"
+#include "hw_hostcall.h"
+#include "debugger.h"
 
 // *******************************************************************************************************************************
 //														   Timing
 // *******************************************************************************************************************************
 
-#define CYCLE_RATE 		(6290*1000)													// Cycles per second (0.96Mhz)
-#define FRAME_RATE		(70)														// Frames per second (50 arbitrary)
 #define CYCLES_PER_FRAME (CYCLE_RATE / FRAME_RATE)									// Cycles per frame (20,000)
+#define CYCLES_CARRIED 	(64) 														// Overrun past this is a hooked routine's
+
+// *******************************************************************************************************************************
+//											Run loop variants, combined as bits
+// *******************************************************************************************************************************
+
+#define CPU_RUN_TRACK 	(1) 														// JSR/RTS tracked for 'C'
+#define CPU_RUN_PROFILE (2) 														// Profiling
+#define CPU_RUN_TRACE 	(4) 														// Binary trace
+#define CPU_RUN_COUNT 	(8) 														// Heatmap and I/O statistics counts
+#define CPU_RUN_BREAK 	(16) 														// Checking breakpoints
+#define CPU_RUN_HLE 	(32) 														// Native versions of hooked routines
+#define CPU_RUN_PAGES 	(64) 														// Page versions kept, for run-ahead and hashing
+
+#define CPU_RUN_INSTRUMENTED (CPU_RUN_TRACK|CPU_RUN_PROFILE|CPU_RUN_TRACE|CPU_RUN_COUNT) // These keep page versions too
+#define CPU_RUN_BUS 	(CPU_RUN_TRACE|CPU_RUN_COUNT|CPU_RUN_PAGES) 				// Bits the bus is a template on
 
 // *******************************************************************************************************************************
 //														CPU / Memory
@@ -38,12 +70,21 @@ static BYTE8 writeProtect;
 static BYTE8 isPageCMemory; 														// Is Page $C000-$DFFF memory.
 static int argumentCount;
 static char **argumentList;
+static int hasReset = 0; 															// Set once the first reset is done.
 static LONG32 cycles;																// Cycle Count.
+static LONG64 cycleBase; 															// Cycles before this frame.
+static LONG64 instructionCount; 													// Instructions executed.
+static LONG32 nextKeyboardSync; 													// Cycle count of next keyboard update
+static LONG32 eventCycle; 															// Cycle count of the next of those, or frame end
+static BYTE8 stopOnDB,stopRequest; 													// Stop the run loop at a $DB ?
 static BYTE8 inFastMode; 															// Fast mode
 static BYTE8 *currentMap;  															// Current map (8 bytes)
 static BYTE8 *currentEditMap; 														// Current edited map (may be NULL)
 static BYTE8 mappingMemory[32]; 													// Current mapped memory.
 static BYTE8 trackingCalls; 														// Tracking JSR/RTS ?
+static BYTE8 profiling; 															// Profiling cycles and calls ?
+static BYTE8 tracing; 																// Writing binary trace ?
+static BYTE8 hooking; 																// High level emulation, 2 if checking
 static BYTE8 MMURegister;	 														// The MMU register
 static BYTE8 IORegister; 															// The I/O Register.
 
@@ -51,19 +92,17 @@ static BYTE8 IORegister; 															// The I/O Register.
 //											 Memory and I/O read and write macros.
 // *******************************************************************************************************************************
 
-#define Read(a) 	_Read(a)														// Basic Read
-#define Write(a,d)	_Write(a,d)														// Basic Write
+#define Read(a) 	BUS::ReadByte(a)													// Basic Read, through the bus policy
+#define Write(a,d)	BUS::WriteByte(a,d)													// Basic Write
 
 #define ReadWord(a) (Read(a) | ((Read((a)+1) << 8)))								// Read 16 bit, Basic
 
 #define Cycles(n) 	cycles += (n)													// Bump Cycles
 
-#define Fetch() 	_Read(pc++)														// Fetch byte
+#define Fetch() 	BUS::ReadByte(pc++)													// Fetch byte
 #define FetchWord()	{ temp16 = Fetch();temp16 |= (Fetch() << 8); }					// Fetch word
 
-static inline BYTE8 _Read(WORD16 address);											// Need to be forward defined as 
-static inline void _Write(WORD16 address,BYTE8 data);								// used in support functions.
-
+#define CORE_LOCAL 																	// Core's work variables are ordinary statics
 #include "processor/__6502support.h"
 
 // *******************************************************************************************************************************
@@ -76,10 +115,33 @@ BYTE8 *CPUAccessMemory(void) {
 	return ramMemory;
 }
 
-static inline BYTE8 _Read(WORD16 address) {
+int CPUMapAddress(WORD16 address) { 												// Physical address, -1 if I/O
+	if (isPageCMemory == 0 && address >= 0xC000 && address < 0xE000) return -1;
+	return MAPPING(address);
+}
+
+BYTE8 CPUPeekMemory(WORD16 address) { 												// What a read would see, but no
+	int physical = CPUMapAddress(address); 											// device handlers are called.
+	if (physical < 0) return IOAccessMemory()[((IORegister & 3) << 14) | (address & 0x3FFF)];
+	if (currentEditMap != NULL && address >= 8 && address < 16) return currentEditMap[address-8];
+	if (address == 0) return MMURegister;
+	if (address == 1) return IORegister;
+	return ramMemory[physical];
+}
+
+// B is CPU_RUN_TRACE, CPU_RUN_COUNT and CPU_RUN_PAGES from the run loop variant. Other accesses (debugger, interrupts,
+// native routines) are outside an instruction, which the trace ignores anyway, and only keep the page versions.
+
+template <int B> static inline BYTE8 _Read(WORD16 address) {
 
 	if (isPageCMemory == 0 && address >= 0xC000 && address < 0xE000) { 				// Hardware check
-		return IOReadMemory(IORegister & 3,address);
+		BYTE8 data = IOReadMemory(IORegister & 3,address);
+		if (B & CPU_RUN_COUNT) {
+			STSIOAccess(IORegister & 3,address,0);
+			HMPCountIO(HMP_READ,IORegister & 3,address);
+		}
+		if (B & CPU_RUN_TRACE) TRCBusAccess(TRC_IOREAD,address,IORegister & 3,data);
+		return data;
 	} 
 
 	if (currentEditMap != NULL && address >= 8 && address < 16) { 					// Access current memory map if editing only.
@@ -90,20 +152,30 @@ static inline BYTE8 _Read(WORD16 address) {
 	if (address == 1) return IORegister;
 
 	int a = MAPPING(address);
+	if (B & CPU_RUN_TRACE) TRCBusAccess(TRC_READ,address,a,ramMemory[a]);
+	if (B & CPU_RUN_COUNT) HMPCount(HMP_READ,a);
 	return ramMemory[a];
 }
 
-static inline void _Write(WORD16 address,BYTE8 data) { 
-	if (address == 0xFFFA) inFastMode = data; 										// Switch fast off/on
+template <int B> static inline void _Write(WORD16 address,BYTE8 data) { 
+	if (address == 0xFFFA) { 														// Switch fast off/on
+		inFastMode = data;
+		eventCycle = 0; 															// Frame end has moved
+	}
 
 	if (address < 16) { 															// Writing in the control area perhaps.
+		if (B & CPU_RUN_TRACE) TRCBusAccess(TRC_WRITE,address,address,data);
 		if (currentEditMap != NULL && address >= 8 && address < 16) { 				// Writing current memory map in editing mode.
 			currentEditMap[address-8] = data;
+			STSAdd(STS_MMU_EDIT,1);
+			HMPRemap(address-8);
 			return;
 		}
 		if (address == 1) IORegister = data;
+		if (address < 2) STSAdd(address == 0 ? STS_MMU_CONTROL:STS_IO_CONTROL,1);
 
 		if (address == 0) {															// Accessing MMU Control
+			HMPRemap(-1);
 			MMURegister = data;
 			currentMap = mappingMemory + 8 * (data & 3); 	 						// Select current usage map.
 			currentEditMap = NULL;
@@ -120,15 +192,34 @@ static inline void _Write(WORD16 address,BYTE8 data) {
 
 
 	if (isPageCMemory == 0 && address >= 0xC000 && address < 0xE000) {				// Hardware check.
+		if (B & CPU_RUN_TRACE) TRCBusAccess(TRC_IOWRITE,address,IORegister & 3,data);
+		if (B & CPU_RUN_COUNT) {
+			STSIOAccess(IORegister & 3,address,-1);
+			HMPCountIO(HMP_WRITE,IORegister & 3,address);
+		}
 		IOWriteMemory(IORegister&3,address,data);
 	} else {
 		int mapAddr = MAPPING(address); 											// Write if in first 512k
+		if (B & CPU_RUN_TRACE) TRCBusAccess(TRC_WRITE,address,mapAddr,data);
 		if (mapAddr < 0x8000000) {
 			ramMemory[mapAddr] = data;
+			if (B & CPU_RUN_COUNT) HMPCount(HMP_WRITE,mapAddr);
+			if (B & CPU_RUN_PAGES) DISPageWritten(mapAddr);
 		}
 	}
 }
 
+// *******************************************************************************************************************************
+//								The F256 bus, a policy for the generated 65C02 core, which is a template on it
+// *******************************************************************************************************************************
+
+template <int B> struct F256Bus {
+	static inline BYTE8 ReadByte(WORD16 address) { return _Read<B>(address); }
+	static inline void WriteByte(WORD16 address,BYTE8 data) { _Write<B>(address,data); }
+};
+
+typedef F256Bus<CPU_RUN_PAGES> F256; 												// Outside the run loop
+
 // *******************************************************************************************************************************
 //													Remember Arguments
 // *******************************************************************************************************************************
@@ -153,8 +244,6 @@ void CPUCopyROM(int address,int size,const BYTE8 *data) {
 #include "roms/__monitor_rom.h"
 #include "roms/character_rom.h"
 
-static void CPULoadChunk(FILE *f,BYTE8* memory,WORD16 address,int count);
-
 void CPUReset(void) {
 	writeProtect = 0;
 	currentMap = mappingMemory; 													// Current access map
@@ -173,6 +262,9 @@ void CPUReset(void) {
 	CPUCopyROM((PAGE_MONITOR << 13),sizeof(__monitor_rom),__monitor_rom); 			// Load the tiny kernal by default to page 7.
 	CPUCopyROM((0x7F << 13),sizeof(__monitor_rom),__monitor_rom); 		       		// Load it also to $7F
 	HWReset();																		// Reset Hardware
+	STSReset(); 																	// Statistics, first time only
+	HMPReset(); 																	// Memory heatmap
+	DISReset(); 																	// Disassembly index, symbols
 
 	#ifdef EMSCRIPTEN  																// Loading in stuff alternative for emScripten
 	#include "loaders.h" 															// Partly because preload storage does not work :(
@@ -180,6 +272,9 @@ void CPUReset(void) {
 
 	int bootAddress = 0x8040;
 	trackingCalls = 0;
+	profiling = 0;
+	tracing = 0;
+	hooking = 0;
 
 	for (int i = 1;i < argumentCount;i++) {
 		char szBuffer[128];
@@ -189,10 +284,83 @@ void CPUReset(void) {
 			mappingMemory[7] = 0x7F; 												// Flash command, boot from $7F
 		} else if (strcmp(szBuffer,"track") == 0) {
 			trackingCalls = -1;
+		} else if (strcmp(szBuffer,"profile") == 0) {
+			profiling = -1;
+			PRFStart();
+		} else if (strcmp(szBuffer,"stats") == 0) { 								// Dump statistics on exit
+			STSEnableJSON();
+		} else if (strcmp(szBuffer,"warp") == 0) { 									// Start unthrottled, first time only
+			if (hasReset == 0) DBGSetWarp(-1); 										// so F11 survives a reset
+		} else if (strcmp(szBuffer,"heatmap") == 0) { 								// Export heatmap on exit
+			HMPEnableExport();
+		} else if (strcmp(szBuffer,"latency") == 0) { 								// Measure keyboard latency
+			LATEnable();
+		} else if (strcmp(szBuffer,"headless") == 0) { 								// No window, unthrottled
+			DBGSetHeadless(-1);
+		} else if (strcmp(szBuffer,"hle") == 0) { 									// Native monitor routines
+			hooking = 1;
+		} else if (strcmp(szBuffer,"hlecheck") == 0) { 							// Same, checked against the 6502
+			hooking = 2;
+		} else if (strcmp(szBuffer,"hostcall") == 0) { 							// Host call registers at $DE80
+			HCLEnable();
+		} else if (strcmp(szBuffer,"audiosync") == 0) { 							// Paced by the sound card
+			SNSetAudioSync(-1);
 		} else {
 			char *p = strchr(szBuffer,'@');
 			if (p == NULL) exit(fprintf(stderr,"Bad argument %s\n",argumentList[i]));
 			*p++ = '\0';
+			if (strcmp(szBuffer,"symbols") == 0) { 								// symbols@<file> 64tass listing
+				if (DISLoadSymbols(p) == 0) exit(fprintf(stderr,"No symbol file %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"type") == 0) { 									// type@<file> once booted
+				if (HWTypeFile(p,HW_TYPE_DELAY) == 0) exit(fprintf(stderr,"No file %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"script") == 0) { 								// script@<file> run a script
+				if (SCRLoad(p) == 0) exit(fprintf(stderr,"No file %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"text") == 0) { 									// text@<file> text display on exit
+				TXTDumpOnExit(p);
+				continue;
+			}
+			if (strcmp(szBuffer,"hashes") == 0) { 								// hashes@<file> display hashes by frame
+				if (HSHOpen(p) == 0) exit(fprintf(stderr,"Cannot create %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"capture") == 0) { 								// capture@<file> frames
+				if (CAPOpen(p) == 0) exit(fprintf(stderr,"Cannot capture to %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"wav") == 0) { 									// wav@<file> sound
+				if (CAPOpenAudio(p) == 0) exit(fprintf(stderr,"Cannot create %s\n",p));
+				continue;
+			}
+			if (strcmp(szBuffer,"audiobuffer") == 0) { 							// audiobuffer@<samples> sound card
+				int samples = atoi(p);
+				if (samples < 64 || samples > 8192 || (samples & (samples-1)) != 0) {
+					exit(fprintf(stderr,"Audio buffer must be a power of 2, 64 to 8192\n"));
+				}
+				SNSetBufferSize(samples);
+				continue;
+			}
+			if (strcmp(szBuffer,"latencytest") == 0) { 							// latencytest@<keys per second>
+				LATStartTest(atof(p));
+				continue;
+			}
+			if (strcmp(szBuffer,"runahead") == 0) { 								// runahead@<frames> speculative display
+				RAHSetFrames(atoi(p));
+				continue;
+			}
+			if (strcmp(szBuffer,"vectors") == 0) { 								// vectors@<path> CPU conformance
+				exit(VECRun(p));
+			}
+			if (strcmp(szBuffer,"trace") == 0) { 									// trace@<file> binary trace
+				tracing = TRCOpen(p);
+				if (tracing == 0) exit(fprintf(stderr,"Cannot create trace file %s\n",p));
+				continue;
+			}
 			loadAddress = -1;
 			if (p[1] == '\0') {
 				if (toupper(p[0]) == 'B') loadAddress = PAGE_BASIC << 13;
@@ -205,24 +373,30 @@ void CPUReset(void) {
 			}
 			if (strcmp(szBuffer,"boot") != 0) {
 				printf("Loading '%s' to $%06x ..",szBuffer,loadAddress);
-				FILE *f = fopen(szBuffer,"rb");
-				if (f == NULL) exit(fprintf(stderr,"No file %s\n",argumentList[i]));
-				while (!feof(f)) {
-					if (loadAddress < MEMSIZE) {
-						ramMemory[loadAddress++] = fgetc(f);
-					}
+				int startAddress;
+				int status = LDRLoad(szBuffer,loadAddress,&startAddress);
+				if (status == LDR_NO_FILE) exit(fprintf(stderr,"No file %s\n",argumentList[i]));
+				if (status == LDR_BAD_FORMAT) exit(fprintf(stderr,"Bad PGX/PGZ file %s\n",argumentList[i]));
+				printf("Okay\n");
+				if (startAddress >= 0) { 											// PGX and PGZ give a start
+					if (startAddress > 0xFFFF) exit(fprintf(stderr,"Start $%06x not in the first 64k\n",startAddress));
+					bootAddress = startAddress;
+					printf("Now booting to $%04x\n",bootAddress);
 				}
-				fclose(f);
-				printf("Okay\n");		
 			} else {
 				printf("Now booting to $%04x\n",bootAddress);
 				bootAddress = loadAddress;
 			}
 		}
 	}
+	hasReset = -1;
+	DISInvalidateAll(); 															// Files loaded without going through _Write
+	if (hooking != 0) HLEInstall(hooking == 2); 									// Symbols are all loaded now
 	inFastMode = 0;																	// Fast mode flag reset
+	nextKeyboardSync = cycles + CYCLES_PER_FRAME / HW_KEYBOARD_SYNCS;
+	eventCycle = 0;
 	writeProtect = -1;
-	resetProcessor();																// Reset CPU
+	resetProcessor<F256>();															// Reset CPU
 	printf("Booting to %04x\n",bootAddress);
 	int patch = (PAGE_MONITOR << 13)+0x1FF8; 										// Where to patch.
 	ramMemory[patch] = bootAddress & 0xFF;
@@ -234,7 +408,12 @@ void CPUReset(void) {
 // *******************************************************************************************************************************
 
 void CPUInterruptMaskable(void) {
-	irqCode();
+	if (profiling != 0 && interruptDisableFlag == 0) { 								// Interrupt will be taken
+		irqCode<F256>();
+		PRFInterrupt(MAPPING(pc),s);
+		return;
+	}
+	irqCode<F256>();
 }
 
 // *******************************************************************************************************************************
@@ -252,32 +431,307 @@ static void CPUTrackCallReturn(BYTE8 opcode) {
 }
 
 // *******************************************************************************************************************************
-//												Execute a single instruction
+//									Profile an instruction, and follow calls and returns
 // *******************************************************************************************************************************
 
-BYTE8 CPUExecuteInstruction(void) {
-	if (pc == 0xFFFF) {
-		printf("CPU $FFFF\n");
-		CPUExit();
-		return FRAME_RATE;
+static void CPUProfileInstruction(BYTE8 opcode,int address,int cycleCount) {
+	PRFInstruction(address,cycleCount); 											// Charged to the caller, even JSR
+	switch(opcode) {
+		case 0x20:																	// JSR
+			PRFCall(MAPPING(pc),s);break;
+		case 0x00: 																	// BRK
+			PRFInterrupt(MAPPING(pc),s);break;
+		case 0x40:																	// RTI, RTS
+		case 0x60:
+			PRFReturn(s);break;
 	}
+}
+
+// *******************************************************************************************************************************
+//
+//		High level emulation. At a hooked routine's entry the native version runs instead. With hlecheck the 6502
+//		version runs first, then the machine is put back, the native version run and the results compared, and the
+//		6502's result kept. Stack below the stack pointer is dead, so is not compared.
+//
+// *******************************************************************************************************************************
+
+static BYTE8 *hleBefore,*hleAfter; 													// RAM then I/O memory, for hlecheck
+
+template <int F> static inline void _CPUInstruction(void);
+
+static void _CPUGetRegisters(struct HLERegisters *r) {
+	r->pc = pc;r->a = a;r->x = x;r->y = y;r->s = s;r->p = constructFlagRegister();
+}
+
+static void _CPUSetRegisters(struct HLERegisters *r) {
+	pc = r->pc;a = r->a;x = r->x;y = r->y;s = r->s;explodeFlagRegister(r->p);
+}
+
+static void _CPUCopyMachine(BYTE8 *target,BYTE8 *source) { 						// Either may be NULL, the machine
+	memcpy(target ? target : ramMemory,source ? source : ramMemory,MEMSIZE);
+	memcpy(target ? target+MEMSIZE : IOAccessMemory(),source ? source+MEMSIZE : IOAccessMemory(),IO_MEMORY_SIZE);
+}
+
+static void _CPUCompareHook(int hook,struct HLERegisters *r6502,LONG32 cycles6502,BYTE8 io6502,struct HLERegisters *r,int n) {
+	char buffer[256];
+	*buffer = '\0';
+	if (r->pc != r6502->pc) sprintf(buffer+strlen(buffer)," pc %04x/%04x",r->pc,r6502->pc);
+	if (r->a != r6502->a) sprintf(buffer+strlen(buffer)," a %02x/%02x",r->a,r6502->a);
+	if (r->x != r6502->x) sprintf(buffer+strlen(buffer)," x %02x/%02x",r->x,r6502->x);
+	if (r->y != r6502->y) sprintf(buffer+strlen(buffer)," y %02x/%02x",r->y,r6502->y);
+	if (r->s != r6502->s) sprintf(buffer+strlen(buffer)," s %02x/%02x",r->s,r6502->s);
+	if ((r->p | 0x30) != (r6502->p | 0x30)) sprintf(buffer+strlen(buffer)," p %02x/%02x",r->p|0x30,r6502->p|0x30);
+	if ((LONG32)n != cycles6502) sprintf(buffer+strlen(buffer)," cycles %d/%d",n,cycles6502);
+	if (IORegister != io6502) sprintf(buffer+strlen(buffer)," $0001 %02x/%02x",IORegister,io6502);
+	int stack = MAPPING(0x100); 													// Dead stack, from here to S
+	for (int i = 0;i < MEMSIZE;i++) {
+		if (ramMemory[i] != hleAfter[i] && (i < stack || i > stack+r6502->s)) {
+			sprintf(buffer+strlen(buffer)," memory $%05x %02x/%02x",i,ramMemory[i],hleAfter[i]);
+			break;
+		}
+	}
+	BYTE8 *io = IOAccessMemory();
+	for (int i = 0;i < IO_MEMORY_SIZE;i++) {
+		if (io[i] != hleAfter[MEMSIZE+i]) {
+			sprintf(buffer+strlen(buffer)," I/O page %d $%04x %02x/%02x",i >> 14,0xC000+(i & 0x3FFF),io[i],hleAfter[MEMSIZE+i]);
+			break;
+		}
+	}
+	HLECheckResult(hook,buffer);
+}
+
+static void _CPUCheckHook(int hook) {
+	struct HLERegisters before,r6502,r;
+	if (hleBefore == NULL) {
+		hleBefore = (BYTE8 *)malloc(MEMSIZE+IO_MEMORY_SIZE);
+		hleAfter = (BYTE8 *)malloc(MEMSIZE+IO_MEMORY_SIZE);
+	}
+	_CPUGetRegisters(&before);
+	LONG32 cycles0 = cycles;
+	BYTE8 io0 = IORegister;
+	_CPUCopyMachine(hleBefore,NULL);
+	WORD16 returnAddress = (_Read<0>(0x100 | ((s+1) & 0xFF)) | (_Read<0>(0x100 | ((s+2) & 0xFF)) << 8)) + 1;
+	BYTE8 returnStack = s+2;
+	while ((pc != returnAddress || s != returnStack) && cycles - cycles0 < HLE_CHECK_LIMIT) {
+		_CPUInstruction<0>(); 														// The 6502 version
+	}
+	if (pc != returnAddress || s != returnStack) { 									// Carry on from where it got to
+		HLECheckResult(hook," not returning");
+		return;
+	}
+	_CPUGetRegisters(&r6502);
+	LONG32 cycles6502 = cycles - cycles0;
+	BYTE8 io6502 = IORegister;
+	_CPUCopyMachine(hleAfter,NULL);
+
+	_CPUCopyMachine(NULL,hleBefore); 												// Back as it was
+	IORegister = io0;isPageCMemory = ((IORegister & 4) != 0);
+	r = before;
+	int n = HLECall(hook,&r); 														// The native version
+	if (n >= 0) _CPUCompareHook(hook,&r6502,cycles6502,io6502,&r,n);
+
+	_CPUCopyMachine(NULL,hleAfter); 												// Keep the 6502's result
+	IORegister = io6502;isPageCMemory = ((IORegister & 4) != 0);
+	_CPUSetRegisters(&r6502);
+	cycles = cycles0 + cycles6502;
+	DISInvalidateAll();
+	HSHInvalidate();
+}
+
+static int _CPUHook(void) { 														// Non zero if the routine was run
+	int physical = CPUMapAddress(pc);
+	int hook = (physical < 0) ? -1 : HLEFind(physical);
+	if (hook < 0) return 0;
+	if (hooking == 2) {
+		_CPUCheckHook(hook);
+		return -1;
+	}
+	struct HLERegisters r;
+	_CPUGetRegisters(&r);
+	int n = HLECall(hook,&r);
+	if (n < 0) return 0;
+	_CPUSetRegisters(&r);
+	Cycles(n);
+	instructionCount++;
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		Execute a single instruction. This is a template on CPU_RUN_xxx, so each run loop variant only has the
+//		instrumentation it needs, and the plain one has none ; it does not even keep the page versions, which are
+//		all bumped when it stops. A $DB stops the run loop before it, unless it is the first instruction run (e.g.
+//		running on from that stop) or single stepping, when it is a one byte no-op.
+//
+// *******************************************************************************************************************************
+
+template <int F> static inline void _CPUInstruction(void) {
+	typedef F256Bus<(F & CPU_RUN_BUS) | ((F & CPU_RUN_INSTRUMENTED) ? CPU_RUN_PAGES : 0)> BUS; // Bus the opcodes use
+	if ((F & CPU_RUN_HLE) && HLEMightHook(pc) && _CPUHook()) return;
+	int profileAddress = (F & CPU_RUN_PROFILE) ? MAPPING(pc) : 0; 					// Physical address, if profiling
+	LONG32 startCycles = cycles;
+	if (F & CPU_RUN_TRACE) TRCBeginInstruction(cycleBase+cycles,pc,a,x,y,s,constructFlagRegister());
+	if (F & CPU_RUN_COUNT) HMPCount(HMP_EXECUTE,MAPPING(pc));
 	BYTE8 opcode = Fetch();															// Fetch opcode.
 
 	//printf("%04x %02x *%02x %02x %02x %02x\n",pc-1,opcode,CPUReadMemory(0x62DC),CPUReadMemory(0x4B),CPUReadMemory(0x4A),y);
 
-	if (trackingCalls != 0) { 														// Tracking for 'C'
+	if (F & CPU_RUN_TRACK) { 														// Tracking for 'C'
 		if (opcode == 0x20 || opcode == 0x60) {
 			CPUTrackCallReturn(opcode);
 		}
 	}
 	switch(opcode) {																// Execute it.
+		case 0xDB: 																	// Break, not an instruction
+			if (stopOnDB == 0) break;
+			pc--;
+			if (F & CPU_RUN_TRACE) TRCCancelInstruction();
+			stopRequest = -1;eventCycle = 0; 										// Stop the loop, it didn't happen
+			return;
 		#include "processor/__6502opcodes.h"
 	}
-	int cycleMax = inFastMode ? CYCLES_PER_FRAME*10:CYCLES_PER_FRAME; 		
-	if (cycles < cycleMax) return 0;												// Not completed a frame.
-	cycles = 0;																		// Reset cycle counter.
-	HWSync();																		// Update any hardware
-	return FRAME_RATE;																// Return frame rate.
+	if (F & CPU_RUN_PROFILE) CPUProfileInstruction(opcode,profileAddress,cycles-startCycles);
+	if (F & CPU_RUN_TRACE) TRCEndInstruction(opcode);
+	instructionCount++;
+}
+
+// *******************************************************************************************************************************
+//
+//		Things that happen at a cycle count rather than every instruction : keyboard syncs during the frame and the
+//		frame end. eventCycle is the next of them, set to 0 to have it worked out again. Returns the frame rate if the
+//		frame ended.
+//
+// *******************************************************************************************************************************
+
+static BYTE8 _CPUEvent(void) {
+	if (cycles >= nextKeyboardSync) { 												// Keyboard moves on during a frame
+		nextKeyboardSync += CYCLES_PER_FRAME / HW_KEYBOARD_SYNCS;
+		HWKeyboardSync(0);
+	}
+	LONG32 cycleMax = inFastMode ? CYCLES_PER_FRAME*10:CYCLES_PER_FRAME; 
+	BYTE8 frameRate = 0;
+	if (cycles >= cycleMax) { 														// Completed a frame.
+		LONG32 carried = (cycles - cycleMax > CYCLES_CARRIED) ? cycles - cycleMax : 0;	// Into the next frame(s)
+		cycleBase += cycles - carried;
+		cycles = carried;																// Reset cycle counter.
+		nextKeyboardSync = CYCLES_PER_FRAME / HW_KEYBOARD_SYNCS;
+		STSAdd(STS_FRAMES,1);
+		HMPEndFrame();
+		HWSync();																	// Update any hardware
+		frameRate = FRAME_RATE;
+		cycleMax = inFastMode ? CYCLES_PER_FRAME*10:CYCLES_PER_FRAME;
+	}
+	eventCycle = (nextKeyboardSync < cycleMax) ? nextKeyboardSync : cycleMax;
+	return frameRate;
+}
+
+static BYTE8 _CPUHalt(void) { 														// Ran to $FFFF
+	printf("CPU $FFFF\n");
+	CPUExit();
+	return FRAME_RATE;
+}
+
+template <int F> static BYTE8 _CPUStep(void) {
+	if (pc == 0xFFFF) return _CPUHalt();
+	_CPUInstruction<F>();
+	return (cycles < eventCycle) ? 0 : _CPUEvent();
+}
+
+// *******************************************************************************************************************************
+//
+//		Run loop, to a breakpoint, a $DB or the end of the frame. Only CPU_RUN_BREAK variants compare breakpoints ;
+//		the others are for when both are 0 (none). Returns the frame rate on frame end, 0 if stopped.
+//
+// *******************************************************************************************************************************
+
+template <int F> static BYTE8 _CPURun(WORD16 breakPoint1,WORD16 breakPoint2) {
+	for (;;) {
+		while (cycles < eventCycle) {
+			if (pc == 0xFFFF) return _CPUHalt();
+			_CPUInstruction<F>();
+			if ((F & CPU_RUN_BREAK) && (pc == breakPoint1 || pc == breakPoint2)) return 0;
+		}
+		if (stopRequest) { 															// At a $DB
+			stopRequest = 0;eventCycle = 0;
+			return 0;
+		}
+		BYTE8 r = _CPUEvent();
+		if (r != 0) return r;
+	}
+}
+
+typedef BYTE8 (*RUNFUNCTION)(WORD16,WORD16);
+typedef BYTE8 (*STEPFUNCTION)(void);
+
+static const STEPFUNCTION stepVariants[16] = {
+	_CPUStep<0>,_CPUStep<1>,_CPUStep<2>,_CPUStep<3>,_CPUStep<4>,_CPUStep<5>,_CPUStep<6>,_CPUStep<7>,
+	_CPUStep<8>,_CPUStep<9>,_CPUStep<10>,_CPUStep<11>,_CPUStep<12>,_CPUStep<13>,_CPUStep<14>,_CPUStep<15>
+};
+
+static const RUNFUNCTION runVariants[32] = {
+	_CPURun<0>,_CPURun<1>,_CPURun<2>,_CPURun<3>,_CPURun<4>,_CPURun<5>,_CPURun<6>,_CPURun<7>,
+	_CPURun<8>,_CPURun<9>,_CPURun<10>,_CPURun<11>,_CPURun<12>,_CPURun<13>,_CPURun<14>,_CPURun<15>,
+	_CPURun<16>,_CPURun<17>,_CPURun<18>,_CPURun<19>,_CPURun<20>,_CPURun<21>,_CPURun<22>,_CPURun<23>,
+	_CPURun<24>,_CPURun<25>,_CPURun<26>,_CPURun<27>,_CPURun<28>,_CPURun<29>,_CPURun<30>,_CPURun<31>
+};
+
+// Hooks only run without instrumentation, which wants to see the 6502 code, and instrumented variants always keep
+// the page versions, so hooks and page versions are just a few more variants.
+
+static int _CPUVariant(void) { 														// Instrumentation in use
+	int variant = (trackingCalls ? CPU_RUN_TRACK : 0) | (profiling ? CPU_RUN_PROFILE : 0) | (tracing ? CPU_RUN_TRACE : 0) |
+										((HMPIsCounting() || STSIsCounting()) ? CPU_RUN_COUNT : 0);
+	if (variant != 0) return variant;
+	return (hooking != 0 ? CPU_RUN_HLE : 0) | (DISPageVersionsWanted() ? CPU_RUN_PAGES : 0);
+}
+
+static STEPFUNCTION _CPUStepFunction(int variant) {
+	switch(variant & (CPU_RUN_HLE|CPU_RUN_PAGES)) {
+		case CPU_RUN_PAGES: 					return _CPUStep<CPU_RUN_PAGES>;
+		case CPU_RUN_HLE: 						return _CPUStep<CPU_RUN_HLE>;
+		case CPU_RUN_HLE|CPU_RUN_PAGES: 		return _CPUStep<CPU_RUN_HLE|CPU_RUN_PAGES>;
+	}
+	return stepVariants[variant];
+}
+
+static RUNFUNCTION _CPURunFunction(int variant) {
+	int isBreak = (variant & CPU_RUN_BREAK) != 0;
+	switch(variant & (CPU_RUN_HLE|CPU_RUN_PAGES)) {
+		case CPU_RUN_PAGES:
+			return isBreak ? _CPURun<CPU_RUN_PAGES|CPU_RUN_BREAK> : _CPURun<CPU_RUN_PAGES>;
+		case CPU_RUN_HLE:
+			return isBreak ? _CPURun<CPU_RUN_HLE|CPU_RUN_BREAK> : _CPURun<CPU_RUN_HLE>;
+		case CPU_RUN_HLE|CPU_RUN_PAGES:
+			return isBreak ? _CPURun<CPU_RUN_HLE|CPU_RUN_PAGES|CPU_RUN_BREAK> : _CPURun<CPU_RUN_HLE|CPU_RUN_PAGES>;
+	}
+	return runVariants[variant];
+}
+
+static void _CPURan(int variant) { 													// Without versions, any page may have changed
+	if ((variant & (CPU_RUN_INSTRUMENTED|CPU_RUN_PAGES)) == 0) DISInvalidateAll();
+}
+
+// *******************************************************************************************************************************
+//												Execute a single instruction
+// *******************************************************************************************************************************
+
+BYTE8 CPUExecuteInstruction(void) {
+	int variant = _CPUVariant();
+	BYTE8 r = _CPUStepFunction(variant)();
+	_CPURan(variant);
+	return r;
+}
+
+// *******************************************************************************************************************************
+//											Cycles executed since power on
+// *******************************************************************************************************************************
+
+LONG64 CPUGetCycleCount(void) {
+	return cycleBase + cycles;
+}
+
+LONG64 CPUGetInstructionCount(void) {
+	return instructionCount;
 }
 
 // *******************************************************************************************************************************
@@ -285,11 +739,35 @@ BYTE8 CPUExecuteInstruction(void) {
 // *******************************************************************************************************************************
 
 BYTE8 CPUReadMemory(WORD16 address) {
-	return Read(address);
+	return _Read<CPU_RUN_PAGES>(address);
 }
 
 void CPUWriteMemory(WORD16 address,BYTE8 data) {
-	Write(address,data);
+	_Write<CPU_RUN_PAGES>(address,data);
+}
+
+// *******************************************************************************************************************************
+//
+//		Single step vectors (sys_vectors) on the emulator's own core, the plain run loop's instruction on the F256 bus.
+//		The machine is made a flat 64k : LUT 0 maps each page to itself and I/O is off, so the physical address is the
+//		CPU address. $0000-$000F are still the MMU and I/O registers, so vectors using them aren't run.
+//
+// *******************************************************************************************************************************
+
+void CPUVectorSetUp(void) {
+	for (int i = 0;i < 8;i++) mappingMemory[i] = i;
+	MMURegister = 0;currentMap = mappingMemory;currentEditMap = NULL;
+	IORegister = 4;isPageCMemory = -1; 											// $C000-$DFFF is RAM
+	stopOnDB = 0;inFastMode = 0;
+	memset(ramMemory,0,0x10000);
+}
+
+int CPUVectorStep(struct FCPState *st) { 											// Returns the cycles taken
+	pc = st->pc;a = st->a;x = st->x;y = st->y;s = st->s;explodeFlagRegister(st->p);
+	LONG32 startCycles = cycles;
+	_CPUInstruction<0>();
+	st->pc = pc;st->a = a;st->x = x;st->y = y;st->s = s;st->p = constructFlagRegister() | 0x10;
+	return cycles - startCycles;
 }
 
 
@@ -297,16 +775,21 @@ void CPUWriteMemory(WORD16 address,BYTE8 data) {
 
 // *******************************************************************************************************************************
 //		Execute chunk of code, to either of two break points or frame-out, return non-zero frame rate on frame, breakpoint 0
+//		The run loop variant is chosen here, the first instruction is run on its own as it may be a $DB or breakpoint.
 // *******************************************************************************************************************************
 
 BYTE8 CPUExecute(WORD16 breakPoint1,WORD16 breakPoint2) { 
-	BYTE8 next;
-	do {
-		BYTE8 r = CPUExecuteInstruction();											// Execute an instruction
-		if (r != 0) return r; 														// Frame out.
-		next = CPUReadMemory(pc);
-	} while (pc != breakPoint1 && pc != breakPoint2 && next != 0xDB);				// Stop on breakpoint or $03 break
-	return 0; 
+	int variant = _CPUVariant();
+	BYTE8 r = _CPUStepFunction(variant)();
+	int hasBreak = (breakPoint1 != 0 || breakPoint2 != 0);
+	if (r == 0 && !(hasBreak && (pc == breakPoint1 || pc == breakPoint2))) { 		// Not framed out or at a breakpoint
+		if (hasBreak) variant |= CPU_RUN_BREAK;
+		stopOnDB = -1;
+		r = _CPURunFunction(variant)(breakPoint1,breakPoint2);
+		stopOnDB = 0;
+	}
+	_CPURan(variant);
+	return r; 
 }
 
 // *******************************************************************************************************************************
@@ -323,6 +806,20 @@ void CPUEndRun(void) {
 	FILE *f = fopen("memory.dump","wb");
 	fwrite(ramMemory,1,MEMSIZE,f);
 	fclose(f);	
+	PRFWriteReport();
+	TRCClose();
+	STSWriteJSON();
+	HMPExportOnExit();
+	RAHReport();
+	LATReport();
+	SNReport();
+	int hleFailed = HLEReport();
+	TXTEndRun();
+	HSHClose();
+	CAPClose();
+	SCREnd(); 																		// Exits with an error if it failed
+	if (hleFailed) exit(1); 														// hlecheck found a hook that differs
+	HCLEndRun(); 																	// Exits with the guest's code if it asked
 }
 
 void CPUExit(void) {	
@@ -331,19 +828,72 @@ void CPUExit(void) {
 	GFXExit();
 }
 
-static char chunkBuffer[4096];
+// *******************************************************************************************************************************
+//
+//		Save and restore machine state, for run-ahead. RAM is shadowed a page at a time ; a page is copied only if its
+//		disassembly version has changed, i.e. it has been written, since the shadow was last brought up to date. While
+//		speculating nothing is profiled, traced or tracked.
+//
+// *******************************************************************************************************************************
+
+static struct _CPUState {
+	BYTE8 a,x,y,s,carryFlag,interruptDisableFlag,breakFlag,decimalFlag,overflowFlag,sValue,zValue;
+	WORD16 pc;
+	LONG32 cycles,nextKeyboardSync;
+	LONG64 cycleBase,instructionCount;
+	BYTE8 inFastMode,isPageCMemory,MMURegister,IORegister,trackingCalls,profiling,tracing;
+	int currentMap,currentEditMap; 													// Offsets in mappingMemory, -1 NULL
+	BYTE8 mappingMemory[32];
+} saved;
+
+static BYTE8 *shadowMemory = NULL; 													// RAM as it was when saved
+static LONG32 shadowVersion[DIS_PAGES]; 											// Page versions the shadow matches
+
+void CPUSaveState(void) {
+	DISWantPageVersions(); 															// From now on
+	if (shadowMemory == NULL) { 													// First time, copy everything.
+		shadowMemory = (BYTE8 *)malloc(MEMSIZE);
+		for (int p = 0;p < DIS_PAGES;p++) shadowVersion[p] = disPageVersion[p]-1;
+	}
+	for (int p = 0;p < DIS_PAGES;p++) {
+		if (shadowVersion[p] != disPageVersion[p]) {
+			memcpy(shadowMemory+(p << 13),ramMemory+(p << 13),0x2000);
+			shadowVersion[p] = disPageVersion[p];
+		}
+	}
+	saved.a = a;saved.x = x;saved.y = y;saved.s = s;saved.pc = pc;
+	saved.carryFlag = carryFlag;saved.interruptDisableFlag = interruptDisableFlag;saved.breakFlag = breakFlag;
+	saved.decimalFlag = decimalFlag;saved.overflowFlag = overflowFlag;saved.sValue = sValue;saved.zValue = zValue;
+	saved.cycles = cycles;saved.nextKeyboardSync = nextKeyboardSync;saved.cycleBase = cycleBase;saved.instructionCount = instructionCount;
+	saved.inFastMode = inFastMode;saved.isPageCMemory = isPageCMemory;
+	saved.MMURegister = MMURegister;saved.IORegister = IORegister;
+	saved.currentMap = currentMap - mappingMemory;
+	saved.currentEditMap = (currentEditMap == NULL) ? -1 : currentEditMap - mappingMemory;
+	memcpy(saved.mappingMemory,mappingMemory,sizeof(mappingMemory));
+	saved.trackingCalls = trackingCalls;saved.profiling = profiling;saved.tracing = tracing;
+	trackingCalls = profiling = tracing = 0;
+	HWSaveState();
+}
 
-static void CPULoadChunk(FILE *f,BYTE8* memory,WORD16 address,int count) {
-	while (count != 0) {
-		int qty = (count > 4096) ? 4096 : count;
-		int n = fread(chunkBuffer,1,qty,f);
-		for (int i = 0;i < n;i++) {
-			int addr = MAPPING(address);
-			ramMemory[addr+i] = chunkBuffer[i];
+void CPURestoreState(void) {
+	for (int p = 0;p < DIS_PAGES;p++) {
+		if (shadowVersion[p] != disPageVersion[p]) { 								// Written while speculating
+			memcpy(ramMemory+(p << 13),shadowMemory+(p << 13),0x2000);
+			DISPageWritten(p << 13); 												// Contents have changed again
+			shadowVersion[p] = disPageVersion[p];
 		}
-		count = count - qty;
-		address = address + qty;
 	}
+	a = saved.a;x = saved.x;y = saved.y;s = saved.s;pc = saved.pc;
+	carryFlag = saved.carryFlag;interruptDisableFlag = saved.interruptDisableFlag;breakFlag = saved.breakFlag;
+	decimalFlag = saved.decimalFlag;overflowFlag = saved.overflowFlag;sValue = saved.sValue;zValue = saved.zValue;
+	cycles = saved.cycles;nextKeyboardSync = saved.nextKeyboardSync;eventCycle = 0;cycleBase = saved.cycleBase;instructionCount = saved.instructionCount;
+	inFastMode = saved.inFastMode;isPageCMemory = saved.isPageCMemory;
+	MMURegister = saved.MMURegister;IORegister = saved.IORegister;
+	memcpy(mappingMemory,saved.mappingMemory,sizeof(mappingMemory));
+	currentMap = mappingMemory + saved.currentMap;
+	currentEditMap = (saved.currentEditMap < 0) ? NULL : mappingMemory + saved.currentEditMap;
+	trackingCalls = saved.trackingCalls;profiling = saved.profiling;tracing = saved.tracing;
+	HWRestoreState();
 }
 
 // *******************************************************************************************************************************
@@ -357,7 +907,7 @@ CPUSTATUS *CPUGetStatus(void) {
 	st.carry = carryFlag;st.interruptDisable = interruptDisableFlag;st.zero = (zValue == 0);
 	st.decimal = decimalFlag;st.brk = breakFlag;st.overflow = overflowFlag;
 	st.sign = (sValue & 0x80) != 0;st.status = constructFlagRegister();
-	st.cycles = cycles;
+	st.cycles = cycleBase+cycles; 													// Monotonic, not per frame
 	for (int i = 0;i < 8;i++) st.mapping[i] = currentMap[i];
 	return &st;
 }
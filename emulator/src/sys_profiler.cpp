@@ -0,0 +1,203 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_profiler.cpp
+//		Purpose:	6502 Profiler - cycles per physical PC, and an inclusive call tree built from JSR/RTS/RTI/IRQ
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "sys_processor.h"
+#include "sys_profiler.h"
+
+// *******************************************************************************************************************************
+//
+//		Each node in the call tree is one routine reached by one particular path. Children are found through a hash keyed
+//		on parent and routine address, so a JSR costs a single lookup however many callees a routine has.
+//
+// *******************************************************************************************************************************
+
+struct _ProfileNode {
+	int 	address; 																// Physical address of routine (-1 root)
+	int 	parent; 																// Parent node, -1 for root.
+	BYTE8 	isInterrupt; 															// Entered by IRQ/BRK rather than JSR
+	LONG64 	selfCycles; 															// Cycles spent in this node only.
+	LONG64 	calls; 																	// Times entered.
+	LONG64 	inclusive; 																// Calculated when reporting.
+};
+
+struct _ProfileFrame {
+	int 	node; 																	// Node this frame is executing
+	BYTE8 	returnSP; 																// Stack pointer once this frame has returned.
+};
+
+static int isEnabled = 0;
+static LONG64 *pcCycles = NULL; 													// Cycles per physical address
+static std::vector<struct _ProfileNode> nodes; 										// Call tree.
+static std::unordered_map<LONG64,int> children; 									// (parent,address,type) -> node
+static std::vector<struct _ProfileFrame> callStack; 								// Current call stack.
+static int currentNode; 															// Node being charged.
+
+// *******************************************************************************************************************************
+//											Start (or restart after a reset) profiling
+// *******************************************************************************************************************************
+
+void PRFStart(void) {
+	if (!isEnabled) {
+		isEnabled = -1;
+		pcCycles = (LONG64 *)calloc(MEMSIZE,sizeof(LONG64));
+		struct _ProfileNode root = { -1,-1,0,0,1,0 };
+		nodes.push_back(root);
+	}
+	callStack.clear(); 																// A reset loses the stack, not the counts.
+	currentNode = 0;
+}
+
+int PRFIsEnabled(void) {
+	return isEnabled;
+}
+
+// *******************************************************************************************************************************
+//													Charge one instruction
+// *******************************************************************************************************************************
+
+void PRFInstruction(int address,int cycles) {
+	pcCycles[address] += cycles;
+	nodes[currentNode].selfCycles += cycles;
+}
+
+// *******************************************************************************************************************************
+//											Enter a routine, by JSR or by interrupt
+// *******************************************************************************************************************************
+
+static void _PRFEnter(int target,BYTE8 returnSP,BYTE8 isInterrupt) {
+	if (callStack.size() >= PRF_MAX_DEPTH) return; 									// Runaway, charge to the caller.
+	LONG64 key = (((LONG64)currentNode) << 24) | (target << 1) | isInterrupt;
+	auto it = children.find(key);
+	int node;
+	if (it == children.end()) { 													// New path to this routine.
+		struct _ProfileNode n = { target,currentNode,isInterrupt,0,0,0 };
+		node = (int)nodes.size();
+		nodes.push_back(n);
+		children[key] = node;
+	} else {
+		node = it->second;
+	}
+	nodes[node].calls++;
+	struct _ProfileFrame f = { currentNode,returnSP };
+	callStack.push_back(f); 														// Remember where we return to
+	currentNode = node;
+}
+
+void PRFCall(int target,BYTE8 sp) {
+	_PRFEnter(target,(sp+2) & 0xFF,0); 												// JSR pushed 2 bytes
+}
+
+void PRFInterrupt(int target,BYTE8 sp) {
+	_PRFEnter(target,(sp+3) & 0xFF,1); 												// IRQ/BRK pushed 3 bytes
+}
+
+// *******************************************************************************************************************************
+//
+//		RTS or RTI. Unwind every frame whose stack level has now been passed ; this copes with routines that discard their
+//		own return address and return to their caller's caller. If no frame has been passed, the RTS is being used as a
+//		computed jump (push address-1, RTS) and is ignored.
+//
+// *******************************************************************************************************************************
+
+void PRFReturn(BYTE8 sp) {
+	while (!callStack.empty() && callStack.back().returnSP <= sp) {
+		currentNode = callStack.back().node;
+		callStack.pop_back();
+	}
+}
+
+// *******************************************************************************************************************************
+//														Report helpers
+// *******************************************************************************************************************************
+
+static void _PRFNodeName(char *buffer,int node) {
+	if (nodes[node].address < 0) {
+		sprintf(buffer,"[top]");
+	} else {
+		sprintf(buffer,"%s$%05x",nodes[node].isInterrupt ? "[irq]":"",nodes[node].address);
+	}
+}
+
+static void _PRFWritePath(FILE *f,int node) {
+	char name[32];
+	if (nodes[node].parent >= 0) {
+		_PRFWritePath(f,nodes[node].parent);
+		fputc(';',f);
+	}
+	_PRFNodeName(name,node);
+	fputs(name,f);
+}
+
+static int _PRFHasAncestor(int node,int address) {
+	for (node = nodes[node].parent;node >= 0;node = nodes[node].parent) {
+		if (nodes[node].address == address) return -1;
+	}
+	return 0;
+}
+
+// *******************************************************************************************************************************
+//							Write the folded stacks file and the top-N hotspot tables
+// *******************************************************************************************************************************
+
+void PRFWriteReport(void) {
+	if (!isEnabled) return;
+	FILE *f = fopen(PRF_FOLDED_FILE,"w"); 											// Folded stacks, one line per path.
+	if (f != NULL) {
+		for (int i = 0;i < (int)nodes.size();i++) {
+			if (nodes[i].selfCycles != 0) {
+				_PRFWritePath(f,i);
+				fprintf(f," %llu\n",nodes[i].selfCycles);
+			}
+		}
+		fclose(f);
+	}
+	for (int i = (int)nodes.size()-1;i >= 0;i--) { 								// Children always follow parents
+		nodes[i].inclusive += nodes[i].selfCycles;
+		if (nodes[i].parent >= 0) nodes[nodes[i].parent].inclusive += nodes[i].inclusive;
+	}
+	LONG64 total = nodes[0].inclusive;
+	if (total == 0) total = 1;
+
+	f = fopen(PRF_REPORT_FILE,"w");
+	if (f == NULL) return;
+	std::vector<int> hot; 															// Hottest physical addresses
+	for (int i = 0;i < MEMSIZE;i++) if (pcCycles[i] != 0) hot.push_back(i);
+	std::sort(hot.begin(),hot.end(),[](int a,int b) { return pcCycles[a] > pcCycles[b]; });
+	fprintf(f,"Total cycles %llu\n\nHottest instructions (self cycles)\n\n",nodes[0].inclusive);
+	for (int i = 0;i < (int)hot.size() && i < PRF_TOP_COUNT;i++) {
+		fprintf(f,"  $%05x  %14llu  %6.2f%%\n",hot[i],pcCycles[hot[i]],100.0*pcCycles[hot[i]]/total);
+	}
+
+	std::unordered_map<int,LONG64> selfByRoutine,inclusiveByRoutine,callsByRoutine;
+	for (int i = 1;i < (int)nodes.size();i++) { 									// Merge paths into routines
+		int a = nodes[i].address;
+		selfByRoutine[a] += nodes[i].selfCycles;
+		callsByRoutine[a] += nodes[i].calls;
+		if (!_PRFHasAncestor(i,a)) inclusiveByRoutine[a] += nodes[i].inclusive; 	// Don't count recursion twice
+	}
+	std::vector<int> routines;
+	for (auto &r : inclusiveByRoutine) routines.push_back(r.first);
+	std::sort(routines.begin(),routines.end(),[&](int a,int b) { return inclusiveByRoutine[a] > inclusiveByRoutine[b]; });
+	fprintf(f,"\nHottest routines (inclusive cycles)\n\n");
+	fprintf(f,"  Routine          Inclusive          Self        Calls\n");
+	for (int i = 0;i < (int)routines.size() && i < PRF_TOP_COUNT;i++) {
+		int a = routines[i];
+		fprintf(f,"  $%05x  %14llu %6.2f%% %14llu %12llu\n",a,inclusiveByRoutine[a],100.0*inclusiveByRoutine[a]/total,
+															selfByRoutine[a],callsByRoutine[a]);
+	}
+	fclose(f);
+	printf("Profile written to %s and %s\n",PRF_REPORT_FILE,PRF_FOLDED_FILE);
+}
@@ -0,0 +1,94 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_runahead.cpp
+//		Purpose:	Input run-ahead. The display shows the machine some frames in the future, so a key shows up as many
+//					frames sooner ; the state is put back afterwards. Also measures input to display latency.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "sys_debug_system.h"
+#include "hardware.h"
+#include "sys_runahead.h"
+#include "sys_hash.h"
+
+static int isEnabled = 0; 															// runahead@n given
+static int aheadFrames = 0; 														// Frames to run ahead
+static LONG64 keyTime = 0; 															// When the pending key arrived, 0 none
+static LONG64 keyDisplay; 															// Display hash at that time
+static LONG64 lastDisplay = 0; 														// Hash of the last frame shown
+static int latencyCount = 0;
+static double latencyTotal,latencyMin,latencyMax; 									// In ms
+
+// *******************************************************************************************************************************
+//										Set the number of frames, 0 measures only
+// *******************************************************************************************************************************
+
+void RAHSetFrames(int frames) {
+	isEnabled = -1;
+	aheadFrames = (frames < 0) ? 0 : (frames > RAH_MAX_FRAMES ? RAH_MAX_FRAMES : frames);
+}
+
+// *******************************************************************************************************************************
+//
+//		A key has been queued. Time it from here to the first frame shown that is different, if there is one soon enough.
+//
+// *******************************************************************************************************************************
+
+void RAHKeyEvent(void) {
+	if (isEnabled == 0 || keyTime != 0) return; 									// Already timing one.
+	keyTime = SDL_GetPerformanceCounter();
+	keyDisplay = lastDisplay;
+}
+
+static void _RAHCheckLatency(void) {
+	lastDisplay = HSHDisplayHash();
+	if (keyTime == 0) return;
+	double ms = (double)(SDL_GetPerformanceCounter() - keyTime) * 1000.0 / SDL_GetPerformanceFrequency();
+	if (lastDisplay != keyDisplay) {
+		if (latencyCount == 0 || ms < latencyMin) latencyMin = ms;
+		if (latencyCount == 0 || ms > latencyMax) latencyMax = ms;
+		latencyTotal += ms;latencyCount++;
+		keyTime = 0;
+	}
+	if (ms > RAH_TIMEOUT) keyTime = 0; 												// Didn't change the display.
+}
+
+// *******************************************************************************************************************************
+//
+//		Draw the display as it will be aheadFrames frames on, stopping early on a breakpoint. Returns zero if not
+//		enabled, when the caller draws as normal.
+//
+// *******************************************************************************************************************************
+
+int RAHRender(int *address) {
+	if (isEnabled == 0) return 0;
+	if (aheadFrames != 0) {
+		CPUSaveState();
+		for (int i = 0;i < aheadFrames;i++) {
+			if (CPUExecute(address[3],address[3]) == 0) break;
+		}
+	}
+	DBGXRender(address,1);
+	_RAHCheckLatency();
+	if (aheadFrames != 0) CPURestoreState();
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//													Report on exit
+// *******************************************************************************************************************************
+
+void RAHReport(void) {
+	if (isEnabled == 0) return;
+	printf("Run-ahead %d frames : ",aheadFrames);
+	if (latencyCount == 0) { printf("no key presses changed the display\n");return; }
+	printf("%d keys, input to display %.1f ms average, %.1f min, %.1f max\n",
+							latencyCount,latencyTotal/latencyCount,latencyMin,latencyMax);
+}
@@ -0,0 +1,274 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_script.cpp
+//		Purpose:	Script runner. A line based command file types text and keys, runs frames, waits for text on the
+//					display, checks memory and dumps the display, then exits with 0 (passed) or 1 (failed).
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "sys_processor.h"
+#include "hardware.h"
+#include "sys_text.h"
+#include "sys_hash.h"
+#include "sys_script.h"
+
+struct _Command {
+	int 	type; 																	// SCR_TYPE etc.
+	int 	line; 																	// Line in the script, for messages
+	int 	count; 																	// Length of text, frames, bytes
+	int 	address; 																// For assert
+	int 	timeout; 																// For wait
+	char 	text[SCR_MAX_TEXT+1]; 													// Text, bytes, or file name
+};
+
+static struct _Command *commands = NULL;
+static int commandCount = 0;
+static int current = 0; 															// Command being executed
+static int isStarted = 0; 															// Current command has started
+static int remaining = 0; 															// Frames left for frames and wait
+static int frameCount = 0;
+static int isFinished = 0,hasFailed = 0;
+static char scriptName[128];
+static LONG32 waitVersions[TXT_MAX_ROWS]; 											// Rows wait has searched
+static LONG64 settleHash; 															// Display hash settle is watching
+static int settleFrames; 															// Frames it has been the same
+
+static const struct { const char *name; int ascii; } keyNames[] = { 				// Named keys, as their typed character
+	{ "enter",'\n' },{ "return",'\n' },{ "escape",27 },{ "backspace",8 },{ "tab",9 },{ "space",' ' },
+	{ "left",2 },{ "right",6 },{ "up",16 },{ "down",14 },{ "home",1 },{ "end",5 },{ "delete",4 },
+	{ NULL,0 }
+};
+
+// *******************************************************************************************************************************
+//
+//		Copy text, which may be in quotes, handling \n \t \\ \" escapes. Returns a pointer after it, with the length in
+//		count. Unquoted text runs to the first space if toSpace is set, otherwise to the end of the line.
+//
+// *******************************************************************************************************************************
+
+static const char *_SCRText(const char *p,char *text,int *count,int toSpace) {
+	int n = 0,isQuoted = (*p == '"');
+	if (isQuoted) p++;
+	while (*p != '\0' && n < SCR_MAX_TEXT) {
+		if (isQuoted && *p == '"') { p++;break; }
+		if (!isQuoted && toSpace && *p == ' ') break;
+		int c = *p++;
+		if (c == '\\' && *p != '\0') {
+			c = *p++;
+			if (c == 'n') c = '\n';
+			if (c == 't') c = '\t';
+		}
+		text[n++] = c;
+	}
+	text[n] = '\0';
+	*count = n;
+	while (*p == ' ') p++;
+	return p;
+}
+
+// *******************************************************************************************************************************
+//									Parse one command, returns an error message or NULL
+// *******************************************************************************************************************************
+
+static const char *_SCRParse(char *p,struct _Command *c) {
+	char word[16];
+	int n = 0;
+	while (isalpha(*p) && n < 15) word[n++] = tolower(*p++);
+	word[n] = '\0';
+	while (*p == ' ') p++;
+	c->count = c->address = c->timeout = 0;c->text[0] = '\0';
+
+	if (strcmp(word,"type") == 0) { 												// type <text>
+		c->type = SCR_TYPE;
+		_SCRText(p,c->text,&c->count,0);
+		return (c->count == 0) ? "Nothing to type" : NULL;
+	}
+	if (strcmp(word,"key") == 0) { 													// key <name> or key <character>
+		c->type = SCR_KEY;
+		c->count = 1;
+		for (int i = 0;keyNames[i].name != NULL;i++) {
+			if (strcmp(p,keyNames[i].name) == 0) { c->text[0] = keyNames[i].ascii;return NULL; }
+		}
+		if (p[0] == '\0' || p[1] != '\0') return "Unknown key";
+		c->text[0] = p[0];
+		return NULL;
+	}
+	if (strcmp(word,"frames") == 0) { 												// frames <n>
+		c->type = SCR_FRAMES;
+		c->count = atoi(p);
+		return (c->count <= 0) ? "Bad frame count" : NULL;
+	}
+	if (strcmp(word,"wait") == 0) { 												// wait <text> [<timeout frames>]
+		c->type = SCR_WAIT;
+		p = (char *)_SCRText(p,c->text,&c->count,-1);
+		c->timeout = (*p == '\0') ? SCR_WAIT_TIMEOUT : atoi(p);
+		return (c->count == 0 || c->timeout <= 0) ? "Bad wait" : NULL;
+	}
+	if (strcmp(word,"settle") == 0) { 												// settle <frames> [<timeout frames>]
+		c->type = SCR_SETTLE;
+		char *end;
+		c->count = strtol(p,&end,10);
+		while (*end == ' ') end++;
+		c->timeout = (*end == '\0') ? SCR_WAIT_TIMEOUT : atoi(end);
+		return (c->count <= 0 || c->timeout <= 0) ? "Bad settle" : NULL;
+	}
+	if (strcmp(word,"assert") == 0) { 												// assert <address> <byte> ...
+		c->type = SCR_ASSERT;
+		char *end;
+		c->address = strtol(p,&end,16);
+		if (end == p) return "Bad address";
+		for (;;) {
+			p = end;
+			int b = strtol(p,&end,16);
+			if (end == p) break;
+			if (b < 0 || b > 0xFF || c->count == SCR_MAX_TEXT) return "Bad byte";
+			c->text[c->count++] = b;
+		}
+		while (*p == ' ') p++;
+		return (c->count == 0 || *p != '\0') ? "Bad bytes" : NULL;
+	}
+	if (strcmp(word,"screen") == 0) { 												// screen [<file>]
+		c->type = SCR_SCREEN;
+		strncpy(c->text,p,SCR_MAX_TEXT);c->text[SCR_MAX_TEXT] = '\0';
+		return NULL;
+	}
+	return "Unknown command";
+}
+
+// *******************************************************************************************************************************
+//					Load a script, replacing any previous one. Errors stop the emulator. Returns 0 if no file.
+// *******************************************************************************************************************************
+
+int SCRLoad(const char *fileName) {
+	char line[SCR_MAX_TEXT+64];
+	FILE *f = fopen(fileName,"r");
+	if (f == NULL) return 0;
+	commandCount = 0;
+	int lineNumber = 0,allocated = 0;
+	while (fgets(line,sizeof(line),f) != NULL) {
+		lineNumber++;
+		int n = strlen(line);
+		while (n > 0 && isspace(line[n-1])) line[--n] = '\0';
+		char *p = line;
+		while (isspace(*p)) p++;
+		if (*p == '\0' || *p == '#') continue; 										// Blank, or comment
+		if (commandCount == allocated) {
+			allocated += 64;
+			commands = (struct _Command *)realloc(commands,allocated * sizeof(struct _Command));
+		}
+		struct _Command *c = &commands[commandCount++];
+		c->line = lineNumber;
+		const char *error = _SCRParse(p,c);
+		if (error != NULL) exit(fprintf(stderr,"%s line %d : %s\n",fileName,lineNumber,error));
+	}
+	fclose(f);
+	strncpy(scriptName,fileName,sizeof(scriptName)-1);
+	current = isStarted = frameCount = isFinished = hasFailed = 0;
+	printf("Loaded %d script commands from %s\n",commandCount,fileName);
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//											Stop, showing the display if it failed
+// *******************************************************************************************************************************
+
+static void _SCRStop(const char *message,int line) {
+	isFinished = -1;
+	if (message != NULL) {
+		hasFailed = -1;
+		printf("%s line %d : %s (frame %d)\n",scriptName,line,message,frameCount);
+		TXTDump(stdout,0);
+	} else {
+		printf("%s passed (%d frames)\n",scriptName,frameCount);
+	}
+	CPUExit();
+}
+
+// *******************************************************************************************************************************
+//
+//		Called at the end of every (real) frame. Commands run until one has to wait for frames to pass ; nothing runs
+//		while text is still being typed. wait only searches rows written since it last looked.
+//
+// *******************************************************************************************************************************
+
+void SCRFrame(void) {
+	char message[SCR_MAX_TEXT+64];
+	if (commandCount == 0 || isFinished) return;
+	frameCount++;
+	while (current < commandCount) {
+		if (HWTypeBusy()) return;
+		struct _Command *c = &commands[current];
+		if (!isStarted) {
+			isStarted = -1;
+			remaining = (c->type == SCR_WAIT || c->type == SCR_SETTLE) ? c->timeout : c->count;
+			settleFrames = -1;
+			for (int i = 0;i < TXT_MAX_ROWS;i++) waitVersions[i] = txtRowVersion[i]-1; // wait searches every row first
+		}
+		switch(c->type) {
+			case SCR_TYPE:
+			case SCR_KEY:
+				HWTypeText(c->text,c->count,0);
+				break;
+			case SCR_FRAMES:
+				if (remaining-- > 0) return;
+				break;
+			case SCR_WAIT:
+				if (TXTFind(c->text,waitVersions) >= 0) break;
+				if (remaining-- > 0) return;
+				sprintf(message,"timed out waiting for \"%s\"",c->text);
+				_SCRStop(message,c->line);
+				return;
+			case SCR_SETTLE: { 														// Display hash the same for count frames
+				LONG64 hash = HSHDisplayHash();
+				if (settleFrames >= 0 && hash == settleHash) {
+					settleFrames++;
+				} else {
+					settleFrames = 0;settleHash = hash;
+				}
+				if (settleFrames >= c->count) break;
+				if (remaining-- > 0) return;
+				_SCRStop("display did not settle",c->line);
+				return;
+			}
+			case SCR_ASSERT:
+				for (int i = 0;i < c->count;i++) {
+					int a = c->address + i;
+					int b = (a <= 0xFFFF) ? CPUPeekMemory(a) : CPUAccessMemory()[a % MEMSIZE]; // No side effects
+					if (b != (c->text[i] & 0xFF)) {
+						sprintf(message,"$%x is $%02x not $%02x",a,b,c->text[i] & 0xFF);
+						_SCRStop(message,c->line);
+						return;
+					}
+				}
+				break;
+			case SCR_SCREEN:
+				if (c->text[0] == '\0') {
+					TXTDump(stdout,0);
+				} else {
+					FILE *f = fopen(c->text,"w");
+					if (f != NULL) { TXTDump(f,0);fclose(f); }
+				}
+				break;
+		}
+		current++;isStarted = 0;
+	}
+	_SCRStop(NULL,0);
+}
+
+// *******************************************************************************************************************************
+//							On exit, if there was a script which did not pass, exit with an error
+// *******************************************************************************************************************************
+
+void SCREnd(void) {
+	if (commandCount == 0) return;
+	if (!isFinished) printf("%s did not finish\n",scriptName);
+	if (hasFailed || !isFinished) exit(1);
+}
@@ -0,0 +1,175 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_stats.cpp
+//		Purpose:	Hot path statistics, performance overlay and JSON dump.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "sys_stats.h"
+
+static LONG64 counters[STS_COUNTERS];
+static LONG64 timers[STS_TIMERS]; 													// In performance counter ticks
+static LONG64 ioCount[STS_DEVICES][2]; 											// Reads, Writes
+static BYTE8 page0Device[0x2000 >> 4]; 												// Device for each 16 bytes of page 0
+static int isInitialised = 0;
+static int showOverlay = 0;
+static int writeJSON = 0;
+
+static const char *counterNames[STS_COUNTERS] = { "frames","mmu_control_writes","io_control_writes","mmu_edit_writes","dma_bytes" };
+static const char *timerNames[STS_TIMERS] = { "cpu","frame_wait","render_background","render_tilemap","render_bitmap",
+											  "render_sprite","render_text","present" };
+static const char *deviceNames[STS_DEVICES] = { "vicky","sound","keyboard","timer","interrupt","rng","sprite","text_lut",
+												"joystick","dma","other","page1","text","colour" };
+static const char *deviceShort[STS_DEVICES] = { "VKY","SND","KBD","TMR","INT","RNG","SPR","TLT","JOY","DMA","OTH","PG1","TXT","COL" };
+
+// *******************************************************************************************************************************
+//												Set up the device range table
+// *******************************************************************************************************************************
+
+static void _STSSetRange(int from,int to,int device) {
+	for (int a = from;a <= to;a += 16) page0Device[(a - 0xC000) >> 4] = device;
+}
+
+void STSReset(void) {
+	if (isInitialised) return; 														// Counts run across resets
+	isInitialised = 1;
+	memset(counters,0,sizeof(counters));memset(timers,0,sizeof(timers));memset(ioCount,0,sizeof(ioCount));
+	_STSSetRange(0xC000,0xDFFF,STS_DEV_OTHER);
+	_STSSetRange(0xD000,0xD5FF,STS_DEV_VICKY);
+	_STSSetRange(0xD600,0xD63F,STS_DEV_SOUND);
+	_STSSetRange(0xD640,0xD64F,STS_DEV_KEYBOARD);
+	_STSSetRange(0xD650,0xD65F,STS_DEV_TIMER);
+	_STSSetRange(0xD660,0xD66F,STS_DEV_INTERRUPT);
+	_STSSetRange(0xD6A0,0xD6AF,STS_DEV_RNG);
+	_STSSetRange(0xD800,0xD87F,STS_DEV_TEXTLUT);
+	_STSSetRange(0xD900,0xDAFF,STS_DEV_SPRITE);
+	_STSSetRange(0xDC00,0xDC0F,STS_DEV_JOYSTICK);
+	_STSSetRange(0xDF00,0xDF1F,STS_DEV_DMA);
+}
+
+void STSEnableJSON(void) {
+	writeJSON = -1;
+}
+
+int STSIsCounting(void) { 															// I/O accesses wanted, costs time
+	return writeJSON || showOverlay;
+}
+
+// *******************************************************************************************************************************
+//														Counting
+// *******************************************************************************************************************************
+
+void STSAdd(int counter,LONG64 n) {
+	counters[counter] += n;
+}
+
+void STSIOAccess(BYTE8 page,WORD16 address,int isWrite) {
+	int device = (page == 0) ? page0Device[(address & 0x1FFF) >> 4] : STS_DEV_PAGE1+page-1;
+	ioCount[device][isWrite ? 1 : 0]++;
+}
+
+LONG64 STSTime(void) {
+	return SDL_GetPerformanceCounter();
+}
+
+void STSAddTime(int timer,LONG64 startTime) {
+	timers[timer] += SDL_GetPerformanceCounter() - startTime;
+}
+
+// *******************************************************************************************************************************
+//
+//								Overlay, showing rates over the last second (F10 toggles)
+//
+// *******************************************************************************************************************************
+
+static LONG64 lastTime,lastCycles,lastInstructions;
+static LONG64 lastCounters[STS_COUNTERS],lastTimers[STS_TIMERS],lastIO[STS_DEVICES][2];
+static char overlay[8][96];
+static int overlayLines = 0;
+
+void STSToggleOverlay(void) {
+	showOverlay = !showOverlay;
+	lastTime = 0;overlayLines = 0;
+}
+
+int STSOverlayShown(void) {
+	return showOverlay;
+}
+
+static void _STSUpdateOverlay(void) {
+	LONG64 now = SDL_GetPerformanceCounter();
+	double seconds = (double)(now - lastTime) / SDL_GetPerformanceFrequency();
+	if (lastTime != 0 && seconds < 1.0) return; 									// Update once a second.
+	if (lastTime != 0) {
+		double frames = counters[STS_FRAMES]-lastCounters[STS_FRAMES];
+		if (frames < 1) frames = 1;
+		double msFrame[STS_TIMERS]; 												// Milliseconds per frame
+		for (int i = 0;i < STS_TIMERS;i++) {
+			msFrame[i] = 1000.0 * (timers[i]-lastTimers[i]) / SDL_GetPerformanceFrequency() / frames;
+		}
+		double mhz = (CPUGetCycleCount()-lastCycles) / seconds / 1e6;
+		overlayLines = 0;
+		sprintf(overlay[overlayLines++],"FPS %.1f  CPU %.2fMHz  Instr/s %.2fM",frames/seconds,mhz,
+														(CPUGetInstructionCount()-lastInstructions)/seconds/1e6);
+		sprintf(overlay[overlayLines++],"ms/frame CPU %.2f Wait %.2f Present %.2f",msFrame[STS_TIME_CPU],msFrame[STS_TIME_WAIT],
+														msFrame[STS_TIME_PRESENT]);
+		sprintf(overlay[overlayLines++],"Render Bgr %.2f Tile %.2f Bmp %.2f Spr %.2f Text %.2f",msFrame[STS_TIME_BACKGROUND],
+							msFrame[STS_TIME_TILEMAP],msFrame[STS_TIME_BITMAP],msFrame[STS_TIME_SPRITE],msFrame[STS_TIME_TEXT]);
+		sprintf(overlay[overlayLines++],"Per sec MMU %.0f IO %.0f LUT %.0f DMA %.0fb",
+							(counters[STS_MMU_CONTROL]-lastCounters[STS_MMU_CONTROL])/seconds,
+							(counters[STS_IO_CONTROL]-lastCounters[STS_IO_CONTROL])/seconds,
+							(counters[STS_MMU_EDIT]-lastCounters[STS_MMU_EDIT])/seconds,
+							(counters[STS_DMA_BYTES]-lastCounters[STS_DMA_BYTES])/seconds);
+		char *p = overlay[overlayLines];*p = '\0'; 								// I/O reads/writes per second
+		for (int i = 0;i < STS_DEVICES;i++) {
+			LONG64 r = ioCount[i][0]-lastIO[i][0],w = ioCount[i][1]-lastIO[i][1];
+			if (r+w != 0) {
+				if (strlen(p) > 40) { overlayLines++;p = overlay[overlayLines];*p = '\0'; }
+				sprintf(p+strlen(p),"%s %.0f/%.0f ",deviceShort[i],r/seconds,w/seconds);
+			}
+		}
+		if (*p != '\0') overlayLines++;
+	}
+	lastTime = now;lastCycles = CPUGetCycleCount();lastInstructions = CPUGetInstructionCount();
+	memcpy(lastCounters,counters,sizeof(counters));memcpy(lastTimers,timers,sizeof(timers));memcpy(lastIO,ioCount,sizeof(ioCount));
+}
+
+void STSRenderOverlay(void) {
+	if (!showOverlay) return;
+	_STSUpdateOverlay();
+	for (int i = 0;i < overlayLines;i++) {
+		GFXString(8,8+i*18,overlay[i],2,0xFF0,0x000);
+	}
+}
+
+// *******************************************************************************************************************************
+//												JSON dump on exit
+// *******************************************************************************************************************************
+
+void STSWriteJSON(void) {
+	if (!writeJSON) return;
+	FILE *f = fopen(STS_JSON_FILE,"w");
+	if (f == NULL) return;
+	double frequency = SDL_GetPerformanceFrequency();
+	fprintf(f,"{\n\t\"cycles\": %llu,\n\t\"instructions\": %llu,\n",CPUGetCycleCount(),CPUGetInstructionCount());
+	for (int i = 0;i < STS_COUNTERS;i++) fprintf(f,"\t\"%s\": %llu,\n",counterNames[i],counters[i]);
+	fprintf(f,"\t\"time_ms\": {\n");
+	for (int i = 0;i < STS_TIMERS;i++) {
+		fprintf(f,"\t\t\"%s\": %.3f%s\n",timerNames[i],1000.0*timers[i]/frequency,(i < STS_TIMERS-1) ? ",":"");
+	}
+	fprintf(f,"\t},\n\t\"io\": {\n");
+	for (int i = 0;i < STS_DEVICES;i++) {
+		fprintf(f,"\t\t\"%s\": { \"reads\": %llu, \"writes\": %llu }%s\n",deviceNames[i],ioCount[i][0],ioCount[i][1],
+																			(i < STS_DEVICES-1) ? ",":"");
+	}
+	fprintf(f,"\t}\n}\n");
+	fclose(f);
+}
@@ -0,0 +1,176 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_text.cpp
+//		Purpose:	Reading the text display (I/O pages 2 and 3) as host text, tracking which rows have been written so
+//					searching and hashing only look at rows that have changed. Writes only mark a 16 byte block, which
+//					is turned into rows when they are next looked at.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "sys_processor.h"
+#include "hardware.h"
+#include "sys_text.h"
+
+BYTE8 txtBlockWritten[TXT_BLOCKS];
+int txtAnyWritten = 0;
+
+LONG32 txtRowVersion[TXT_MAX_ROWS]; 												// Bumped when a row has been written
+static LONG64 rowHash[TXT_MAX_ROWS]; 												// Hash of each row's text and colour
+static LONG32 rowHashVersion[TXT_MAX_ROWS]; 										// Row version it was made from
+static int lastSize = -1; 															// Columns and rows when rows were made
+static char dumpFile[128]; 															// text@<file>, written on exit
+
+// *******************************************************************************************************************************
+//							Size of the text display, from $D001 (as the display renderer uses it)
+// *******************************************************************************************************************************
+
+int TXTColumns(void) {
+	return (IOReadMemory(0,0xD001) & 2) ? TXT_MAX_COLUMNS/2 : TXT_MAX_COLUMNS;
+}
+
+int TXTRows(void) {
+	int size = IOReadMemory(0,0xD001);
+	int rows = (size & 1) ? 50 : 60;
+	return (size & 4) ? rows/2 : rows;
+}
+
+// *******************************************************************************************************************************
+//
+//		Bump the version of every row in a written block, or of all rows if written without telling us or the display
+//		size has changed, which moves the rows.
+//
+// *******************************************************************************************************************************
+
+static void _TXTUpdateRows(void) {
+	int columns = TXTColumns(),size = columns * 256 + TXTRows();
+	if (size != lastSize) {
+		lastSize = size;
+		TXTInvalidate();
+	}
+	if (txtAnyWritten == 0) return;
+	txtAnyWritten = 0;
+	for (int b = 0;b < TXT_BLOCKS;b++) {
+		if (txtBlockWritten[b] == 0) continue;
+		txtBlockWritten[b] = 0;
+		int last = (b*16+15) / columns;
+		if (last >= TXT_MAX_ROWS) last = TXT_MAX_ROWS-1;
+		for (int row = b*16 / columns;row <= last;row++) txtRowVersion[row]++;
+	}
+}
+
+void TXTInvalidate(void) {
+	for (int i = 0;i < TXT_MAX_ROWS;i++) txtRowVersion[i]++;
+}
+
+// *******************************************************************************************************************************
+//									Get one row as text, characters with no ASCII equivalent are '.'
+// *******************************************************************************************************************************
+
+void TXTRow(int row,char *buffer) {
+	int columns = TXTColumns();
+	for (int x = 0;x < columns;x++) {
+		int c = IOReadMemory(2,0xC000+x+row*columns);
+		buffer[x] = (c >= ' ' && c < 0x7F) ? c : '.';
+	}
+	buffer[columns] = '\0';
+}
+
+void TXTColourRow(int row,char *buffer) { 											// Two hex digits a character, fgr bgr
+	int columns = TXTColumns();
+	for (int x = 0;x < columns;x++) {
+		sprintf(buffer+x*2,"%02x",IOReadMemory(3,0xC000+x+row*columns));
+	}
+	buffer[columns*2] = '\0';
+}
+
+// *******************************************************************************************************************************
+//
+//		Look for text in rows whose version differs from the caller's copy, which is brought up to date. Returns the row
+//		it was found on, or -1. Setting a row's copy to anything else makes it be searched again.
+//
+// *******************************************************************************************************************************
+
+int TXTFind(const char *text,LONG32 *versions) {
+	char buffer[TXT_MAX_COLUMNS+1];
+	int rows = TXTRows();
+	_TXTUpdateRows();
+	for (int row = 0;row < rows;row++) {
+		if (versions[row] == txtRowVersion[row]) continue;
+		versions[row] = txtRowVersion[row];
+		TXTRow(row,buffer);
+		if (strstr(buffer,text) != NULL) return row;
+	}
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		64 bit hash of the text, colour and size of the display. Each row's hash is kept, and only worked out again if
+//		the row has been written, so this costs little more than combining the row hashes.
+//
+// *******************************************************************************************************************************
+
+LONG64 TXTHash(void) {
+	int columns = TXTColumns(),rows = TXTRows();
+	_TXTUpdateRows();
+	LONG64 hash = TXT_FNV_BASIS;
+	hash = (hash ^ (columns * 256 + rows)) * TXT_FNV_PRIME;
+	for (int row = 0;row < rows;row++) {
+		if (rowHashVersion[row] != txtRowVersion[row]) {
+			rowHashVersion[row] = txtRowVersion[row];
+			LONG64 h = TXT_FNV_BASIS;
+			for (int x = 0;x < columns;x++) {
+				h = (h ^ IOReadMemory(2,0xC000+x+row*columns)) * TXT_FNV_PRIME;
+				h = (h ^ IOReadMemory(3,0xC000+x+row*columns)) * TXT_FNV_PRIME;
+			}
+			rowHash[row] = h;
+		}
+		hash = (hash ^ rowHash[row]) * TXT_FNV_PRIME;
+	}
+	return hash;
+}
+
+// *******************************************************************************************************************************
+//						Write the display out, trailing spaces removed, then the colours if wanted
+// *******************************************************************************************************************************
+
+void TXTDump(FILE *f,int withColours) {
+	char buffer[TXT_MAX_COLUMNS*2+1];
+	int rows = TXTRows();
+	for (int row = 0;row < rows;row++) {
+		TXTRow(row,buffer);
+		int n = strlen(buffer);
+		while (n > 0 && buffer[n-1] == ' ') n--;
+		buffer[n] = '\0';
+		fprintf(f,"%s\n",buffer);
+	}
+	if (withColours) {
+		fprintf(f,"\n");
+		for (int row = 0;row < rows;row++) {
+			TXTColourRow(row,buffer);
+			fprintf(f,"%s\n",buffer);
+		}
+	}
+}
+
+// *******************************************************************************************************************************
+//									text@<file> writes text and colours on exit, - is stdout
+// *******************************************************************************************************************************
+
+void TXTDumpOnExit(const char *fileName) {
+	strncpy(dumpFile,fileName,sizeof(dumpFile)-1);
+}
+
+void TXTEndRun(void) {
+	if (dumpFile[0] == '\0') return;
+	FILE *f = (strcmp(dumpFile,"-") == 0) ? stdout : fopen(dumpFile,"w");
+	if (f == NULL) return;
+	TXTDump(f,-1);
+	if (f != stdout) fclose(f);
+}
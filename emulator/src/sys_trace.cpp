@@ -0,0 +1,212 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_trace.cpp
+//		Purpose:	Binary execution and bus trace. The CPU thread puts raw 64 bit events into a lock free single producer
+//					single consumer ring, a writer thread packs them and writes them to disk.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include "sys_processor.h"
+#include "sys_trace.h"
+
+// *******************************************************************************************************************************
+//
+//		Raw events in the ring. An instruction is two words, a bus access one.
+//
+//		Instruction 	[63:61] 1 [55:48] opcode [47:0] cycle 		followed by  [55:48] P [47:40] S [39:32] Y [31:24] X [23:16] A [15:0] PC
+//		Bus access 		[63:61] 2+type [47:40] data [35:16] physical address (or I/O page) [15:0] CPU address
+//
+// *******************************************************************************************************************************
+
+#define EV_INSTRUCTION 	(1ULL)
+#define EV_BUS 			(2ULL)
+#define EV_KIND(e) 		((e) >> 61)
+
+static LONG64 *ring = NULL;
+static SDL_atomic_t head,tail; 														// Published write / read positions.
+static SDL_atomic_t stopWriter;
+static LONG32 writeHead; 															// Unpublished write position, wraps.
+static LONG32 instructionStart; 													// Where current instruction header is.
+static int inInstruction = 0; 														// Only log accesses made by the CPU.
+static SDL_Thread *writerThread = NULL;
+static FILE *traceFile = NULL;
+
+static int TRCWriterThread(void *data);
+
+// *******************************************************************************************************************************
+//													Open trace file
+// *******************************************************************************************************************************
+
+int TRCOpen(const char *fileName) {
+	if (traceFile != NULL) return -1; 												// Already open (e.g. after reset)
+	traceFile = fopen(fileName,"wb");
+	if (traceFile == NULL) return 0;
+	fwrite(TRC_MAGIC,1,8,traceFile);
+	ring = (LONG64 *)malloc(TRC_RING_SIZE * sizeof(LONG64));
+	SDL_AtomicSet(&head,0);SDL_AtomicSet(&tail,0);SDL_AtomicSet(&stopWriter,0);
+	writeHead = 0;
+	writerThread = SDL_CreateThread(TRCWriterThread,"trace writer",NULL);
+	printf("Tracing to %s\n",fileName);
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//												Producer side (CPU thread)
+// *******************************************************************************************************************************
+
+static inline void _TRCPut(LONG64 event) {
+	ring[writeHead & (TRC_RING_SIZE-1)] = event;
+	writeHead++;
+}
+
+void TRCBeginInstruction(LONG64 cycle,WORD16 pc,BYTE8 a,BYTE8 x,BYTE8 y,BYTE8 s,BYTE8 p) {
+	while ((LONG32)(writeHead - (LONG32)SDL_AtomicGet(&tail)) > TRC_RING_SIZE - TRC_MAX_EVENTS) { // Wait for the writer to catch up
+		SDL_Delay(0);
+	}
+	instructionStart = writeHead;
+	_TRCPut((EV_INSTRUCTION << 61) | (cycle & 0xFFFFFFFFFFFFULL));
+	_TRCPut(pc | ((LONG64)a << 16) | ((LONG64)x << 24) | ((LONG64)y << 32) | ((LONG64)s << 40) | ((LONG64)p << 48));
+	inInstruction = -1;
+}
+
+void TRCBusAccess(int type,WORD16 address,int physical,BYTE8 data) {
+	if (inInstruction == 0) return; 												// Debugger display, not the CPU
+	if ((LONG32)(writeHead - instructionStart) >= TRC_MAX_EVENTS) return; 			// Can't happen, but protects the ring
+	_TRCPut(((EV_BUS+type) << 61) | ((LONG64)data << 40) | ((LONG64)(physical & 0xFFFFF) << 16) | address);
+}
+
+void TRCCancelInstruction(void) { 													// Stopped before it, e.g. at $DB
+	writeHead = instructionStart;
+	inInstruction = 0;
+}
+
+void TRCEndInstruction(BYTE8 opcode) {
+	ring[instructionStart & (TRC_RING_SIZE-1)] |= ((LONG64)opcode) << 48; 		// Opcode is only known after fetch
+	inInstruction = 0;
+	SDL_MemoryBarrierRelease();
+	SDL_AtomicSet(&head,(int)writeHead); 											// Publish the whole instruction.
+}
+
+// *******************************************************************************************************************************
+//
+//		Consumer side. The file is a stream of records, each packed against the previous state :
+//
+//		Instruction 	1 F P S Y X A : flags, bit set if that register follows. F set if the opcode fetch was elided
+//						varint 		: cycles since last instruction
+//						varint 		: zigzag PC change since last instruction
+//						byte 		: opcode, then changed registers A X Y S P
+//		Operand fetch 	0 0 0 0 1 0 0 0 : read of the next byte after the opcode, same page ; data byte follows
+//		Bus access 		0 0 0 0 0 n t t : t = access type, n = physical page / I/O page follows
+//						2 bytes 	: CPU address, then data byte, then page if n set
+//
+// *******************************************************************************************************************************
+
+static BYTE8 packBuffer[65536];
+static int packSize;
+static LONG64 lastCycle;
+static int lastPC,lastRegs[5],lastPage[9];
+static int nextFetch; 																// Address of next operand fetch.
+
+static void _TRCByte(int b) {
+	packBuffer[packSize++] = b;
+}
+
+static void _TRCVarInt(LONG64 n) {
+	while (n >= 0x80) { _TRCByte((n & 0x7F) | 0x80); n >>= 7; }
+	_TRCByte((int)n);
+}
+
+static int _TRCPackInstruction(LONG64 e1,LONG64 e2,LONG64 fetch) {
+	int regs[5] = { (int)(e2 >> 16) & 0xFF,(int)(e2 >> 24) & 0xFF,(int)(e2 >> 32) & 0xFF,(int)(e2 >> 40) & 0xFF,(int)(e2 >> 48) & 0xFF };
+	int pc = (int)(e2 & 0xFFFF);
+	int opcode = (int)(e1 >> 48) & 0xFF;
+	int flags = 0x80;
+	for (int i = 0;i < 5;i++) if (regs[i] != lastRegs[i]) flags |= (1 << i);
+	int elide = EV_KIND(fetch) == EV_BUS+TRC_READ && (fetch & 0xFFFF) == (LONG64)pc && 	// Opcode fetch that says nothing new ?
+				(int)((fetch >> 40) & 0xFF) == opcode && (int)((fetch >> 29) & 0x7F) == lastPage[pc >> 13];
+	if (elide) flags |= 0x40;
+	_TRCByte(flags);
+	LONG64 cycle = e1 & 0xFFFFFFFFFFFFULL;
+	_TRCVarInt(cycle - lastCycle);lastCycle = cycle;
+	int pcDelta = pc - lastPC;lastPC = pc;
+	_TRCVarInt((LONG32)((pcDelta << 1) ^ (pcDelta >> 31)));
+	_TRCByte(opcode);
+	for (int i = 0;i < 5;i++) {
+		if (flags & (1 << i)) _TRCByte(regs[i]);
+		lastRegs[i] = regs[i];
+	}
+	nextFetch = (pc+1) & 0xFFFF;
+	return elide;
+}
+
+static void _TRCPackBus(LONG64 e1) {
+	int type = (int)EV_KIND(e1) - EV_BUS;
+	int address = e1 & 0xFFFF;
+	int page = (int)(e1 >> 16) & 0xFFFFF;
+	page = (type >= TRC_IOREAD) ? page : (page >> 13); 								// I/O page, or physical 8k page
+	int slot = (type >= TRC_IOREAD) ? 8 : (address >> 13);
+	int newPage = (page != lastPage[slot]);
+	if (type == TRC_READ && address == nextFetch && !newPage) { 					// Operand fetch.
+		_TRCByte(8);
+		_TRCByte((int)(e1 >> 40) & 0xFF);
+		nextFetch = (nextFetch+1) & 0xFFFF;
+		return;
+	}
+	_TRCByte(type | (newPage ? 4 : 0));
+	_TRCByte(address & 0xFF);_TRCByte(address >> 8);
+	_TRCByte((int)(e1 >> 40) & 0xFF);
+	if (newPage) _TRCByte(page);
+	lastPage[slot] = page;
+	nextFetch = -1; 																// Operands always come first.
+}
+
+static int TRCWriterThread(void *data) {
+	lastCycle = 0;lastPC = 0;
+	for (int i = 0;i < 5;i++) lastRegs[i] = 0;
+	for (int i = 0;i < 9;i++) lastPage[i] = -1;
+	for (;;) {
+		int stopping = SDL_AtomicGet(&stopWriter); 								// Read before head, so nothing is lost.
+		LONG32 h = (LONG32)SDL_AtomicGet(&head); 										// Unsigned, so positions wrap safely.
+		LONG32 t = (LONG32)SDL_AtomicGet(&tail);
+		if (h == t) {
+			if (stopping) return 0; 												// Drained and told to stop.
+			SDL_Delay(1);
+			continue;
+		}
+		SDL_MemoryBarrierAcquire();
+		packSize = 0;
+		while (t != h && packSize < (int)sizeof(packBuffer)-256) {
+			LONG64 e1 = ring[t & (TRC_RING_SIZE-1)];t++;
+			if (EV_KIND(e1) == EV_INSTRUCTION) {
+				LONG64 e2 = ring[t & (TRC_RING_SIZE-1)];t++;
+				LONG64 fetch = (t != h) ? ring[t & (TRC_RING_SIZE-1)] : 0; 		// Published with the header.
+				if (_TRCPackInstruction(e1,e2,fetch)) t++;
+			} else {
+				_TRCPackBus(e1);
+			}
+		}
+		fwrite(packBuffer,1,packSize,traceFile);
+		SDL_AtomicSet(&tail,(int)t); 												// Release the space.
+	}
+}
+
+// *******************************************************************************************************************************
+//											Flush everything and close the file
+// *******************************************************************************************************************************
+
+void TRCClose(void) {
+	if (traceFile == NULL) return;
+	SDL_AtomicSet(&stopWriter,1);
+	SDL_WaitThread(writerThread,NULL);
+	fclose(traceFile);
+	traceFile = NULL;
+	free(ring);ring = NULL;
+}
@@ -0,0 +1,554 @@
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+//
+//		Name:		sys_vectors.cpp
+//		Purpose:	vectors@<file or directory> runs single step test vectors (each an initial state and RAM, the final
+//					state and RAM, and the bus cycles) on every core variant, split across host threads. Files are the
+//					JSON single step tests, one file an opcode, or the same converted by scripts/vectorbin.py, which
+//					load much faster. Mismatches with the vectors are reported by opcode ; a variant which doesn't
+//					agree with the reference, the emulator's own core, fails the run.
+//		Created:	19th October 2026
+//		Author:		Paul Robson (paul@robsons.org.uk)
+//
+// *******************************************************************************************************************************
+// *******************************************************************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+#include "gfx.h"
+#include "sys_processor.h"
+#include "sys_flatcpu.h"
+#include "sys_vectors.h"
+#include "processor/__6502mnemonics.h"
+
+#define VEC_VARIANTS 	(3) 														// f256 (the reference), flat, logged
+
+struct _VECResult {
+	struct FCPState st;
+	int 	cycles;
+	int 	writeCount; 															// -1 if the variant can't tell
+	WORD16 	writeAddress[VEC_MAX_WRITES];
+	BYTE8 	writeData[VEC_MAX_WRITES];
+	BYTE8 	ram[VEC_MAX_RAM]; 														// At the final state's addresses
+};
+
+struct _VECWork {
+	struct VECVector *vectors;
+	struct _VECResult *reference; 													// The f256 results, cycles -1 if not run
+	int 	count;
+	LONG64 	failed[VEC_VARIANTS][256]; 												// Variant, opcode
+	int 	failedFields[VEC_VARIANTS][256];
+	LONG64 	disagreed;
+	int 	reported;
+	char 	report[VEC_MAX_REPORT][160];
+};
+
+static const char *fieldNames[VEC_BAD_COUNT] = { "pc","a","x","y","s","p","ram","cycles","writes" };
+
+// *******************************************************************************************************************************
+//
+//		Core variants. Each sets up a vector, runs it, and fills in the result. The first is the emulator's own core,
+//		the reference the others have to agree with. It uses the emulator's state, so it runs on one thread before
+//		the others, and can't run vectors using $0000-$000F (the MMU and I/O registers), which are checked against
+//		the flat core instead. A faster core goes in this table.
+//
+// *******************************************************************************************************************************
+
+static int _VECUsesF256Registers(struct VECVector *v) {
+	for (int i = 0;i < v->initial.ramCount;i++) if (v->initial.ramAddress[i] < 16) return -1;
+	for (int i = 0;i < v->final.ramCount;i++) if (v->final.ramAddress[i] < 16) return -1;
+	for (int i = 0;i < v->writeCount && i < VEC_MAX_WRITES;i++) if (v->writeAddress[i] < 16) return -1;
+	return 0;
+}
+
+static void _VECF256(struct VECVector *v,struct _VECResult *r) {
+	BYTE8 *memory = CPUAccessMemory();
+	r->cycles = -1;
+	if (_VECUsesF256Registers(v)) return;
+	for (int i = 0;i < v->initial.ramCount;i++) memory[v->initial.ramAddress[i]] = v->initial.ramData[i];
+	r->st.pc = v->initial.pc;r->st.a = v->initial.a;r->st.x = v->initial.x;r->st.y = v->initial.y;
+	r->st.s = v->initial.s;r->st.p = v->initial.p;
+	r->cycles = CPUVectorStep(&r->st);
+	r->writeCount = -1;
+	for (int i = 0;i < v->final.ramCount;i++) r->ram[i] = memory[v->final.ramAddress[i]];
+	for (int i = 0;i < v->initial.ramCount;i++) memory[v->initial.ramAddress[i]] = 0;
+	for (int i = 0;i < v->final.ramCount;i++) memory[v->final.ramAddress[i]] = 0;
+}
+
+static void _VECSetUp(struct VECVector *v) {
+	BYTE8 *memory = FCPMemory();
+	for (int i = 0;i < v->initial.ramCount;i++) memory[v->initial.ramAddress[i]] = v->initial.ramData[i];
+	struct FCPState st;
+	st.pc = v->initial.pc;st.a = v->initial.a;st.x = v->initial.x;st.y = v->initial.y;
+	st.s = v->initial.s;st.p = v->initial.p;
+	FCPSetState(&st);
+}
+
+static void _VECFinish(struct VECVector *v,struct _VECResult *r) { 				// Get the results and clear up
+	BYTE8 *memory = FCPMemory();
+	FCPGetState(&r->st);
+	for (int i = 0;i < v->final.ramCount;i++) r->ram[i] = memory[v->final.ramAddress[i]];
+	for (int i = 0;i < v->initial.ramCount;i++) memory[v->initial.ramAddress[i]] = 0;
+	for (int i = 0;i < v->final.ramCount;i++) memory[v->final.ramAddress[i]] = 0;
+}
+
+static void _VECFlat(struct VECVector *v,struct _VECResult *r) {
+	_VECSetUp(v);
+	r->cycles = FCPStep();
+	r->writeCount = -1;
+	_VECFinish(v,r);
+}
+
+static void _VECLogged(struct VECVector *v,struct _VECResult *r) {
+	struct FCPAccess log[VEC_MAX_ACCESSES];
+	int count;
+	_VECSetUp(v);
+	r->cycles = FCPStepLogged(log,VEC_MAX_ACCESSES,&count);
+	r->writeCount = 0;
+	for (int i = 0;i < count && i < VEC_MAX_ACCESSES;i++) {
+		if (log[i].isWrite) {
+			if (r->writeCount < VEC_MAX_WRITES) {
+				r->writeAddress[r->writeCount] = log[i].address;r->writeData[r->writeCount] = log[i].data;
+			}
+			r->writeCount++;
+		}
+	}
+	_VECFinish(v,r);
+	for (int i = 0;i < r->writeCount && i < VEC_MAX_WRITES;i++) { 				// Stray writes need clearing too
+		FCPMemory()[r->writeAddress[i]] = 0;
+	}
+}
+
+typedef void (*VARIANT)(struct VECVector *v,struct _VECResult *r);
+
+static const VARIANT variants[VEC_VARIANTS] = { _VECF256,_VECFlat,_VECLogged };
+static const char *variantNames[VEC_VARIANTS] = { "f256","flat","logged" };
+
+// *******************************************************************************************************************************
+//									Compare a result with the vector, or another result
+// *******************************************************************************************************************************
+
+static int _VECCompareState(struct FCPState *st,WORD16 pc,BYTE8 a,BYTE8 x,BYTE8 y,BYTE8 s,BYTE8 p) {
+	int bad = 0;
+	if (st->pc != pc) bad |= VEC_BAD_PC;
+	if (st->a != a) bad |= VEC_BAD_A;
+	if (st->x != x) bad |= VEC_BAD_X;
+	if (st->y != y) bad |= VEC_BAD_Y;
+	if (st->s != s) bad |= VEC_BAD_S;
+	if ((st->p | 0x30) != (p | 0x30)) bad |= VEC_BAD_P; 							// B and bit 5 aren't real
+	return bad;
+}
+
+static int _VECCheck(struct VECVector *v,struct _VECResult *r) {
+	int bad = _VECCompareState(&r->st,v->final.pc,v->final.a,v->final.x,v->final.y,v->final.s,v->final.p);
+	for (int i = 0;i < v->final.ramCount;i++) {
+		if (r->ram[i] != v->final.ramData[i]) bad |= VEC_BAD_RAM;
+	}
+	if (r->cycles != v->cycles) bad |= VEC_BAD_CYCLES;
+	if (r->writeCount >= 0) {
+		if (r->writeCount != v->writeCount) {
+			bad |= VEC_BAD_WRITES;
+		} else {
+			for (int i = 0;i < r->writeCount && i < VEC_MAX_WRITES;i++) {
+				if (r->writeAddress[i] != v->writeAddress[i] || r->writeData[i] != v->writeData[i]) bad |= VEC_BAD_WRITES;
+			}
+		}
+	}
+	return bad;
+}
+
+static int _VECAgree(struct VECVector *v,struct _VECResult *r1,struct _VECResult *r2) {
+	int bad = _VECCompareState(&r1->st,r2->st.pc,r2->st.a,r2->st.x,r2->st.y,r2->st.s,r2->st.p);
+	for (int i = 0;i < v->final.ramCount;i++) {
+		if (r1->ram[i] != r2->ram[i]) bad |= VEC_BAD_RAM;
+	}
+	if (r1->cycles != r2->cycles) bad |= VEC_BAD_CYCLES;
+	return bad;
+}
+
+static void _VECDescribe(char *buffer,int bad) {
+	*buffer = '\0';
+	for (int i = 0;i < VEC_BAD_COUNT;i++) {
+		if (bad & (1 << i)) sprintf(buffer+strlen(buffer),"%s%s",(*buffer != '\0') ? " ":"",fieldNames[i]);
+	}
+}
+
+static BYTE8 _VECOpcode(struct VECVector *v) {
+	for (int i = 0;i < v->initial.ramCount;i++) {
+		if (v->initial.ramAddress[i] == v->initial.pc) return v->initial.ramData[i];
+	}
+	return 0;
+}
+
+// *******************************************************************************************************************************
+//									Run a slice of the vectors, on one thread
+// *******************************************************************************************************************************
+
+static void _VECReport(struct _VECWork *w,const char *text) {
+	if (w->reported < VEC_MAX_REPORT) strcpy(w->report[w->reported],text);
+	w->reported++;
+}
+
+static int _VECThread(void *data) {
+	struct _VECWork *w = (struct _VECWork *)data;
+	struct _VECResult results[VEC_VARIANTS];
+	char fields[64],text[160];
+	FCPReset();
+	memset(FCPMemory(),0,0x10000);
+	for (int n = 0;n < w->count;n++) {
+		struct VECVector *v = &w->vectors[n];
+		BYTE8 opcode = _VECOpcode(v);
+		int reference = (w->reference[n].cycles < 0) ? 1 : 0; 						// f256, or flat if it couldn't
+		results[0] = w->reference[n];
+		for (int i = 0;i < VEC_VARIANTS;i++) {
+			if (i > 0) variants[i](v,&results[i]); 									// f256 has been run already
+			if (results[i].cycles < 0) continue;
+			int bad = _VECCheck(v,&results[i]);
+			if (bad != 0) {
+				w->failed[i][opcode]++;
+				w->failedFields[i][opcode] |= bad;
+			}
+			if (i > reference && (bad = _VECAgree(v,&results[i],&results[reference])) != 0) { // Must match the reference
+				w->disagreed++;
+				_VECDescribe(fields,bad);
+				sprintf(text,"\"%s\" : %s and %s differ in %s",v->name,variantNames[i],variantNames[reference],fields);
+				_VECReport(w,text);
+			}
+		}
+	}
+	return 0;
+}
+
+// *******************************************************************************************************************************
+//
+//		JSON. Only as much as the vector files need : an array of objects, with name, initial, final and cycles, and
+//		anything else skipped.
+//
+// *******************************************************************************************************************************
+
+static const char *jp; 																// Position in the text
+static int jsonError;
+
+static void _VECSpace(void) {
+	while (*jp != '\0' && isspace(*jp)) jp++;
+}
+
+static int _VECIs(char c) { 														// Skip c if it's next
+	_VECSpace();
+	if (*jp != c) return 0;
+	jp++;
+	return -1;
+}
+
+static void _VECExpect(char c) {
+	if (!_VECIs(c)) jsonError = -1;
+}
+
+static int _VECNumber(void) {
+	_VECSpace();
+	char *end;
+	long n = strtol(jp,&end,10);
+	if (end == jp) jsonError = -1;
+	jp = end;
+	return (int)n;
+}
+
+static void _VECString(char *buffer,int size) {
+	_VECExpect('"');
+	int n = 0;
+	while (*jp != '"' && *jp != '\0') {
+		if (*jp == '\\' && jp[1] != '\0') jp++;
+		if (n < size-1) buffer[n++] = *jp;
+		jp++;
+	}
+	buffer[n] = '\0';
+	_VECExpect('"');
+}
+
+static void _VECSkip(void) { 														// Any value
+	_VECSpace();
+	if (*jp == '"') {
+		char dummy[4];
+		_VECString(dummy,sizeof(dummy));
+	} else if (*jp == '[' || *jp == '{') {
+		char close = (*jp == '[') ? ']' : '}';
+		jp++;
+		if (_VECIs(close)) return;
+		do {
+			if (close == '}') {
+				char dummy[4];
+				_VECString(dummy,sizeof(dummy));
+				_VECExpect(':');
+			}
+			_VECSkip();
+		} while (_VECIs(',') && jsonError == 0);
+		_VECExpect(close);
+	} else {
+		while (*jp != '\0' && strchr(",]} \t\r\n",*jp) == NULL) jp++;
+	}
+}
+
+static void _VECState(struct VECState *st) {
+	char key[16];
+	st->ramCount = 0;
+	_VECExpect('{');
+	do {
+		_VECString(key,sizeof(key));
+		_VECExpect(':');
+		if (strcmp(key,"pc") == 0) st->pc = _VECNumber();
+		else if (strcmp(key,"s") == 0) st->s = _VECNumber();
+		else if (strcmp(key,"a") == 0) st->a = _VECNumber();
+		else if (strcmp(key,"x") == 0) st->x = _VECNumber();
+		else if (strcmp(key,"y") == 0) st->y = _VECNumber();
+		else if (strcmp(key,"p") == 0) st->p = _VECNumber();
+		else if (strcmp(key,"ram") == 0) { 											// [[address,data],...]
+			_VECExpect('[');
+			if (!_VECIs(']')) {
+				do {
+					_VECExpect('[');
+					int address = _VECNumber();
+					_VECExpect(',');
+					int data = _VECNumber();
+					_VECExpect(']');
+					if (st->ramCount == VEC_MAX_RAM) jsonError = -1;
+					if (jsonError == 0) {
+						st->ramAddress[st->ramCount] = address;st->ramData[st->ramCount++] = data;
+					}
+				} while (_VECIs(',') && jsonError == 0);
+				_VECExpect(']');
+			}
+		}
+		else _VECSkip();
+	} while (_VECIs(',') && jsonError == 0);
+	_VECExpect('}');
+}
+
+static void _VECCycles(struct VECVector *v) { 										// [[address,data,"read"|"write"],...]
+	char type[8];
+	v->cycles = v->writeCount = 0;
+	_VECExpect('[');
+	if (_VECIs(']')) return;
+	do {
+		_VECExpect('[');
+		int address = _VECNumber();
+		_VECExpect(',');
+		int data = _VECNumber();
+		_VECExpect(',');
+		_VECString(type,sizeof(type));
+		_VECExpect(']');
+		v->cycles++;
+		if (strcmp(type,"write") == 0) {
+			if (v->writeCount < VEC_MAX_WRITES) {
+				v->writeAddress[v->writeCount] = address;v->writeData[v->writeCount] = data;
+			}
+			v->writeCount++;
+		}
+	} while (_VECIs(',') && jsonError == 0);
+	_VECExpect(']');
+}
+
+static int _VECParseJSON(const char *text,struct VECVector **vectors) {
+	int count = 0,size = 1024;
+	char key[16];
+	*vectors = (struct VECVector *)malloc(size * sizeof(struct VECVector));
+	jp = text;jsonError = 0;
+	_VECExpect('[');
+	if (_VECIs(']')) return 0;
+	do {
+		if (count == size) {
+			size *= 2;
+			*vectors = (struct VECVector *)realloc(*vectors,size * sizeof(struct VECVector));
+		}
+		struct VECVector *v = &(*vectors)[count++];
+		memset(v,0,sizeof(struct VECVector));
+		_VECExpect('{');
+		do {
+			_VECString(key,sizeof(key));
+			_VECExpect(':');
+			if (strcmp(key,"name") == 0) _VECString(v->name,VEC_NAME);
+			else if (strcmp(key,"initial") == 0) _VECState(&v->initial);
+			else if (strcmp(key,"final") == 0) _VECState(&v->final);
+			else if (strcmp(key,"cycles") == 0) _VECCycles(v);
+			else _VECSkip();
+		} while (_VECIs(',') && jsonError == 0);
+		_VECExpect('}');
+	} while (_VECIs(',') && jsonError == 0);
+	_VECExpect(']');
+	return jsonError ? -1 : count;
+}
+
+// *******************************************************************************************************************************
+//
+//		Binary, from scripts/vectorbin.py. After the header each vector is : name length and name, initial state, final
+//		state, cycles, write count and writes. A state is pc (2) s a x y p, RAM count, then address (2) and data each.
+//		Words are low byte first.
+//
+// *******************************************************************************************************************************
+
+static const BYTE8 *bp,*bEnd;
+
+static int _VECByte(void) {
+	if (bp >= bEnd) { jsonError = -1;return 0; }
+	return *bp++;
+}
+
+static int _VECWord(void) {
+	int n = _VECByte();
+	return n | (_VECByte() << 8);
+}
+
+static void _VECBinaryState(struct VECState *st) {
+	st->pc = _VECWord();st->s = _VECByte();st->a = _VECByte();st->x = _VECByte();st->y = _VECByte();st->p = _VECByte();
+	st->ramCount = _VECByte();
+	if (st->ramCount > VEC_MAX_RAM) { jsonError = -1;return; }
+	for (int i = 0;i < st->ramCount;i++) {
+		st->ramAddress[i] = _VECWord();st->ramData[i] = _VECByte();
+	}
+}
+
+static int _VECParseBinary(const BYTE8 *data,int size,struct VECVector **vectors) {
+	int count = 0,capacity = 1024;
+	*vectors = (struct VECVector *)malloc(capacity * sizeof(struct VECVector));
+	bp = data + strlen(VEC_MAGIC);bEnd = data + size;jsonError = 0;
+	while (bp < bEnd && jsonError == 0) {
+		if (count == capacity) {
+			capacity *= 2;
+			*vectors = (struct VECVector *)realloc(*vectors,capacity * sizeof(struct VECVector));
+		}
+		struct VECVector *v = &(*vectors)[count++];
+		int length = _VECByte();
+		for (int i = 0;i < length;i++) {
+			int c = _VECByte();
+			if (i < VEC_NAME-1) v->name[i] = c;
+		}
+		v->name[(length < VEC_NAME-1) ? length : VEC_NAME-1] = '\0';
+		_VECBinaryState(&v->initial);
+		_VECBinaryState(&v->final);
+		v->cycles = _VECByte();
+		v->writeCount = _VECByte();
+		for (int i = 0;i < v->writeCount;i++) {
+			int address = _VECWord(),data = _VECByte();
+			if (i < VEC_MAX_WRITES) {
+				v->writeAddress[i] = address;v->writeData[i] = data;
+			}
+		}
+	}
+	return jsonError ? -1 : count;
+}
+
+// *******************************************************************************************************************************
+//						Load a file, and run it across the threads, adding the results to the totals
+// *******************************************************************************************************************************
+
+static struct _VECWork work[VEC_MAX_THREADS];
+static LONG64 totalVectors,totalFailed[VEC_VARIANTS][256],totalDisagreed,totalSkipped;
+static int totalFields[VEC_VARIANTS][256],totalReported,threadCount;
+
+static int _VECRunFile(const char *fileName) {
+	FILE *f = fopen(fileName,"rb");
+	if (f == NULL) return 0;
+	fseek(f,0,SEEK_END);
+	long size = ftell(f);
+	fseek(f,0,SEEK_SET);
+	char *data = (char *)malloc(size+1);
+	size = fread(data,1,size,f);
+	data[size] = '\0';
+	fclose(f);
+
+	struct VECVector *vectors;
+	int count;
+	if (size >= (long)strlen(VEC_MAGIC) && memcmp(data,VEC_MAGIC,strlen(VEC_MAGIC)) == 0) {
+		count = _VECParseBinary((BYTE8 *)data,size,&vectors);
+	} else {
+		count = _VECParseJSON(data,&vectors);
+	}
+	free(data);
+	if (count < 0) {
+		free(vectors);
+		exit(fprintf(stderr,"Bad vector file %s\n",fileName));
+	}
+
+	struct _VECResult *reference = (struct _VECResult *)malloc((count+1) * sizeof(struct _VECResult));
+	CPUVectorSetUp(); 																// The emulator's core, on this thread
+	for (int n = 0;n < count;n++) {
+		variants[0](&vectors[n],&reference[n]);
+		if (reference[n].cycles < 0) totalSkipped++;
+	}
+
+	SDL_Thread *threads[VEC_MAX_THREADS];
+	int start = 0;
+	for (int t = 0;t < threadCount;t++) { 											// A slice each
+		int n = (count - start) / (threadCount - t);
+		memset(&work[t],0,sizeof(struct _VECWork));
+		work[t].vectors = vectors + start;work[t].reference = reference + start;work[t].count = n;
+		start += n;
+		threads[t] = SDL_CreateThread(_VECThread,"vectors",&work[t]);
+	}
+	for (int t = 0;t < threadCount;t++) {
+		SDL_WaitThread(threads[t],NULL);
+		for (int i = 0;i < VEC_VARIANTS;i++) {
+			for (int op = 0;op < 256;op++) {
+				totalFailed[i][op] += work[t].failed[i][op];
+				totalFields[i][op] |= work[t].failedFields[i][op];
+			}
+		}
+		totalDisagreed += work[t].disagreed;
+		for (int r = 0;r < work[t].reported && r < VEC_MAX_REPORT;r++) {
+			if (totalReported++ < VEC_MAX_REPORT) printf("%s : %s\n",fileName,work[t].report[r]);
+		}
+	}
+	totalVectors += count;
+	free(reference);
+	free(vectors);
+	return -1;
+}
+
+// *******************************************************************************************************************************
+//
+//		Run a file, or every .json and .bin file in a directory. Returns the exit code, 0 if the variants all agreed.
+//
+// *******************************************************************************************************************************
+
+int VECRun(const char *path) {
+	threadCount = SDL_GetCPUCount();
+	threadCount = (threadCount < 1) ? 1 : (threadCount > VEC_MAX_THREADS ? VEC_MAX_THREADS : threadCount);
+	LONG64 frequency = SDL_GetPerformanceFrequency();
+	LONG64 startTime = SDL_GetPerformanceCounter();
+	int files = 0;
+	DIR *dir = opendir(path);
+	if (dir != NULL) {
+		struct dirent *entry;
+		char fileName[1024];
+		while ((entry = readdir(dir)) != NULL) {
+			const char *ext = strrchr(entry->d_name,'.');
+			if (ext == NULL || (strcmp(ext,".json") != 0 && strcmp(ext,".bin") != 0)) continue;
+			snprintf(fileName,sizeof(fileName),"%s/%s",path,entry->d_name);
+			files += (_VECRunFile(fileName) != 0);
+		}
+		closedir(dir);
+	} else {
+		files += (_VECRunFile(path) != 0);
+	}
+	if (files == 0) exit(fprintf(stderr,"No vectors in %s\n",path));
+
+	double seconds = (double)(SDL_GetPerformanceCounter() - startTime) / frequency;
+	char fields[64];
+	for (int i = 0;i < VEC_VARIANTS;i++) { 											// Differences from the vectors
+		LONG64 failed = 0;
+		for (int op = 0;op < 256;op++) failed += totalFailed[i][op];
+		printf("%-8s : %llu of %llu vectors failed",variantNames[i],failed,totalVectors - (i == 0 ? totalSkipped : 0));
+		if (i == 0 && totalSkipped != 0) printf(" (%llu using $0000-$000F not run)",totalSkipped);
+		printf("\n");
+		for (int op = 0;op < 256 && i == 0;op++) { 									// By opcode, once
+			if (totalFailed[i][op] == 0) continue;
+			_VECDescribe(fields,totalFields[i][op]);
+			printf("           $%02x %-14s %8llu (%s)\n",op,_mnemonics[op],totalFailed[i][op],fields);
+		}
+	}
+	printf("%llu vectors, %d files, %d threads, %.2fs (%.1fM vectors/s), %llu disagreements between variants\n",
+			totalVectors,files,threadCount,seconds,totalVectors / seconds / 1e6,totalDisagreed);
+	return (totalDisagreed != 0) ? 1 : 0;
+}
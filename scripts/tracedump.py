@@ -0,0 +1,170 @@
+# *******************************************************************************************
+# *******************************************************************************************
+#
+#		Name : 		tracedump.py
+#		Purpose :	Decode, print and filter binary traces written by trace@<file>
+#		Date :		19th October 2026
+#		Author : 	Paul Robson (paul@robsons.org.uk)
+#
+# *******************************************************************************************
+# *******************************************************************************************
+
+import argparse,os,re,sys
+
+MAGIC = b"F256TRC\x01"
+ACCESS = [ "R","W","IOR","IOW" ]
+
+# *******************************************************************************************
+#
+#			Mnemonics come from the generated table, if the emulator has been built.
+#
+# *******************************************************************************************
+
+def loadMnemonics():
+	table = os.path.join(os.path.dirname(os.path.abspath(__file__)),"..","emulator","processor","__6502mnemonics.h")
+	if not os.path.exists(table):
+		return [ "byte {0:02x}".format(i) for i in range(0,256) ]
+	return re.findall('"(.*?)"',open(table).read())
+
+# *******************************************************************************************
+#
+#								Decode the packed record stream
+#
+# *******************************************************************************************
+
+class TraceReader(object):
+	def __init__(self,fileName):
+		self.data = open(fileName,"rb").read()
+		if not self.data.startswith(MAGIC):
+			raise Exception("{0} is not a trace file".format(fileName))
+		self.pos = len(MAGIC)
+
+	def byte(self):
+		self.pos += 1
+		return self.data[self.pos-1]
+
+	def varint(self):
+		n = shift = 0
+		while True:
+			b = self.byte()
+			n |= (b & 0x7F) << shift
+			shift += 7
+			if (b & 0x80) == 0:
+				return n
+	#
+	#		Yields (cycle,pc,opcode,[a,x,y,s,p],[(access,address,data,page)])
+	#
+	def instructions(self):
+		cycle = pc = 0
+		regs = [0,0,0,0,0]
+		pages = [-1] * 9
+		current = None
+		fetch = -1
+		while self.pos < len(self.data):
+			tag = self.byte()
+			if tag & 0x80:
+				if current is not None:
+					yield current
+				cycle += self.varint()
+				delta = self.varint()
+				pc = (pc + ((delta >> 1) ^ -(delta & 1))) & 0xFFFF
+				opcode = self.byte()
+				for i in range(0,5):
+					if tag & (1 << i):
+						regs[i] = self.byte()
+				current = (cycle,pc,opcode,list(regs),[])
+				if tag & 0x40:
+					current[4].append((0,pc,opcode,pages[pc >> 13]))
+				fetch = (pc + 1) & 0xFFFF
+			elif tag == 8:
+				current[4].append((0,fetch,self.byte(),pages[fetch >> 13]))
+				fetch = (fetch + 1) & 0xFFFF
+			else:
+				access = tag & 3
+				address = self.byte() | (self.byte() << 8)
+				value = self.byte()
+				slot = 8 if access >= 2 else address >> 13
+				if tag & 4:
+					pages[slot] = self.byte()
+				current[4].append((access,address,value,pages[slot]))
+				fetch = -1
+		if current is not None:
+			yield current
+
+# *******************************************************************************************
+#
+#										Filtering
+#
+# *******************************************************************************************
+
+def parseRange(s):
+	if s is None:
+		return None
+	parts = s.split("-")
+	return (int(parts[0],16),int(parts[-1],16))
+
+def inRange(r,v):
+	return r is None or (v >= r[0] and v <= r[1])
+
+def selected(args,instruction):
+	cycle,pc,opcode,regs,bus = instruction
+	if args.start is not None and cycle < args.start:
+		return False
+	if args.end is not None and cycle > args.end:
+		return False
+	if not inRange(args.pc,pc):
+		return False
+	if args.address is not None or args.writes or args.io:
+		for access,address,value,page in bus:
+			if inRange(args.address,address) and (not args.writes or (access & 1) != 0) and (not args.io or access >= 2):
+				return True
+		return False
+	return True
+
+def disassemble(mnemonics,instruction):
+	cycle,pc,opcode,regs,bus = instruction
+	operand = [ value for access,address,value,page in bus if access == 0 and address in [(pc+1) & 0xFFFF,(pc+2) & 0xFFFF] ]
+	text = mnemonics[opcode]
+	if text.find("@1") >= 0 and len(operand) >= 1:
+		text = text.replace("@1","${0:02x}".format(operand[0]))
+	if text.find("@2") >= 0 and len(operand) >= 2:
+		text = text.replace("@2","${0:02x}{1:02x}".format(operand[1],operand[0]))
+	if text.find("@r") >= 0 and len(operand) >= 1:
+		offset = operand[-1] - 256 if operand[-1] >= 128 else operand[-1]
+		text = text.replace("@r","${0:04x}".format((pc + 1 + len(operand) + offset) & 0xFFFF))
+	return text
+
+def format(mnemonics,instruction):
+	cycle,pc,opcode,regs,bus = instruction
+	s = "{0:12} {1:04x} {2:02x} {3:16} A:{4:02x} X:{5:02x} Y:{6:02x} S:{7:02x} P:{8:02x}".format(cycle,pc,opcode,disassemble(mnemonics,instruction),*regs)
+	for access,address,value,page in bus:
+		where = "p{0}".format(page) if access >= 2 else "{0:05x}".format(((page if page >= 0 else 0) << 13) | (address & 0x1FFF))
+		s += "  {0}:{1:04x}[{2}]={3:02x}".format(ACCESS[access],address,where,value)
+	return s
+
+parser = argparse.ArgumentParser(description = "Print a binary trace written by the emulator's trace@<file> option")
+parser.add_argument("file",help = "trace file")
+parser.add_argument("--pc",help = "only instructions with PC in hex range, e.g. e000-e0ff")
+parser.add_argument("--address",help = "only instructions accessing CPU addresses in hex range")
+parser.add_argument("--writes",action = "store_true",help = "only instructions that write")
+parser.add_argument("--io",action = "store_true",help = "only instructions that access I/O")
+parser.add_argument("--start",type = int,help = "first cycle")
+parser.add_argument("--end",type = int,help = "last cycle")
+parser.add_argument("--limit",type = int,help = "maximum number of instructions to print")
+parser.add_argument("--stats",action = "store_true",help = "print counts only")
+args = parser.parse_args()
+args.pc = parseRange(args.pc)
+args.address = parseRange(args.address)
+
+mnemonics = loadMnemonics()
+count = accesses = 0
+for instruction in TraceReader(args.file).instructions():
+	if selected(args,instruction):
+		count += 1
+		accesses += len(instruction[4])
+		if not args.stats:
+			print(format(mnemonics,instruction))
+		if args.limit is not None and count >= args.limit:
+			break
+if args.stats:
+	print("{0} instructions, {1} bus accesses".format(count,accesses))
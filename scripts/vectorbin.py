@@ -0,0 +1,58 @@
+# *******************************************************************************************
+# *******************************************************************************************
+#
+#		Name : 		vectorbin.py
+#		Purpose :	Convert JSON single step test vectors to the binary form vectors@<path>
+#					loads quickly
+#		Date :		19th October 2026
+#		Author : 	Paul Robson (paul@robsons.org.uk)
+#
+# *******************************************************************************************
+# *******************************************************************************************
+
+import argparse,json,os,struct,sys
+
+MAGIC = b"F256VEC\x01"
+
+# *******************************************************************************************
+#
+#		A state is pc (2) s a x y p, the RAM count, then address (2) and data for each.
+#
+# *******************************************************************************************
+
+def packState(state):
+	data = struct.pack("<HBBBBBB",state["pc"],state["s"],state["a"],state["x"],state["y"],state["p"],len(state["ram"]))
+	for address,value in state["ram"]:
+		data += struct.pack("<HB",address,value)
+	return data
+
+def packVector(vector):
+	name = vector["name"].encode()[:255]
+	writes = [ c for c in vector["cycles"] if c[2] == "write" ]
+	data = struct.pack("<B",len(name)) + name + packState(vector["initial"]) + packState(vector["final"])
+	data += struct.pack("<BB",len(vector["cycles"]),len(writes))
+	for address,value,kind in writes:
+		data += struct.pack("<HB",address,value)
+	return data
+
+def convert(source,target):
+	vectors = json.load(open(source))
+	with open(target,"wb") as h:
+		h.write(MAGIC)
+		for v in vectors:
+			h.write(packVector(v))
+	return len(vectors)
+
+parser = argparse.ArgumentParser(description = "Convert JSON single step test vectors to binary")
+parser.add_argument("source",help = "a .json file, or a directory of them")
+parser.add_argument("target",help = "the .bin file, or a directory for them")
+args = parser.parse_args()
+
+if os.path.isdir(args.source):
+	os.makedirs(args.target,exist_ok = True)
+	for f in sorted(os.listdir(args.source)):
+		if f.endswith(".json"):
+			n = convert(os.path.join(args.source,f),os.path.join(args.target,f[:-5]+".bin"))
+			print("{0} : {1} vectors".format(f,n))
+else:
+	print("{0} vectors".format(convert(args.source,args.target)))